@@ -0,0 +1,427 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "allocator.h"
+
+/* Allocation model, per airport and per day:
+ * - An arrival holds a gate for turnaround minutes after it lands; a departure
+ *   holds one for boardingLead minutes before it leaves. No aircraft rotations
+ *   are known, so the two are planned as separate gate intervals.
+ * - Gates are handed out by a sweep over the intervals in start order: gates
+ *   whose interval ended go back to a free min-heap, the lowest free gate is
+ *   taken. An airline with reserved gates uses those first, then the common
+ *   pool unless its rule is exclusive. A movement with no free gate is
+ *   reported instead of double-booking a gate.
+ * - Every movement needs a runway for runwaySlot minutes. In scheduled order it
+ *   takes the runway that frees first (min-heap) and waits if none is free yet.
+ * The day is planned on its own; intervals running past midnight are not
+ * carried into the next day.
+ */
+
+/* ---- binary min-heap of (key, id); ties go to the lower id ---- */
+
+typedef struct {
+    int key;
+    int id;
+} HeapItem;
+
+typedef struct {
+    HeapItem *items;
+    size_t count;
+} MinHeap;
+
+static int heapLess(HeapItem a, HeapItem b) {
+    if (a.key != b.key) return a.key < b.key;
+    return a.id < b.id;
+}
+
+static void heapPush(MinHeap *h, HeapItem item) {
+    size_t i = h->count++;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!heapLess(item, h->items[parent])) break;
+        h->items[i] = h->items[parent];
+        i = parent;
+    }
+    h->items[i] = item;
+}
+
+static HeapItem heapPop(MinHeap *h) {
+    HeapItem top = h->items[0];
+    HeapItem last = h->items[--h->count];
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= h->count) break;
+        if (child + 1 < h->count && heapLess(h->items[child + 1], h->items[child])) child++;
+        if (!heapLess(h->items[child], last)) break;
+        h->items[i] = h->items[child];
+        i = child;
+    }
+    if (h->count) h->items[i] = last;
+    return top;
+}
+
+/* ---- airport registry ---- */
+
+void initAllocation(Allocation *alloc, AllocRules rules) {
+    memset(alloc, 0, sizeof(*alloc));
+    alloc->rules = rules;
+    alloc->date = DATE_NONE;
+}
+
+static void clearPlans(Allocation *alloc) {
+    AirportAlloc *cur = alloc->airports;
+    while (cur) {
+        AirportAlloc *tmp = cur;
+        cur = cur->next;
+        free(tmp->moves);
+        free(tmp->order);
+        free(tmp);
+    }
+    free(alloc->bySymbol);
+    alloc->airports = NULL;
+    alloc->bySymbol = NULL;
+    alloc->symbolSlots = 0;
+}
+
+void freeAllocation(Allocation *alloc) {
+    clearPlans(alloc);
+    GateRule *rule = alloc->gateRules;
+    while (rule) {
+        GateRule *tmp = rule;
+        rule = rule->next;
+        free(tmp);
+    }
+    initAllocation(alloc, alloc->rules);
+}
+
+static AirportAlloc* findAirportAlloc(const Allocation *alloc, SymbolID name) {
+    if (name >= alloc->symbolSlots) return NULL;
+    return alloc->bySymbol[name];
+}
+
+/* Create and prepend airport entry, growing the lookup table to cover name */
+static AirportAlloc* createAirportAlloc(Allocation *alloc, SymbolID name) {
+    if (name == SYMBOL_NONE) return NULL;
+    if (name >= alloc->symbolSlots) {
+        uint32_t slots = symbolCount() > name ? symbolCount() : name + 1;
+        AirportAlloc **table = (AirportAlloc**)realloc(alloc->bySymbol, sizeof(AirportAlloc*) * slots);
+        if (!table) return NULL;
+        memset(table + alloc->symbolSlots, 0, sizeof(AirportAlloc*) * (slots - alloc->symbolSlots));
+        alloc->bySymbol = table;
+        alloc->symbolSlots = slots;
+    }
+    AirportAlloc *a = (AirportAlloc*)calloc(1, sizeof(AirportAlloc));
+    if (!a) return NULL;
+    a->name = name;
+    a->next = alloc->airports;
+    alloc->airports = a;
+    alloc->bySymbol[name] = a;
+    return a;
+}
+
+int setGateRule(Allocation *alloc, SymbolID airport, SymbolID airline, int gates, int exclusive) {
+    GateRule **link = &alloc->gateRules;
+    while (*link && ((*link)->airport != airport || (*link)->airline != airline)) link = &(*link)->next;
+    if (gates <= 0) {
+        if (*link) {
+            GateRule *victim = *link;
+            *link = victim->next;
+            free(victim);
+        }
+        return 1;
+    }
+    if (!*link) {
+        /* appended, so gate numbers follow the order rules were made */
+        *link = (GateRule*)calloc(1, sizeof(GateRule));
+        if (!*link) return 0;
+        (*link)->airport = airport;
+        (*link)->airline = airline;
+    }
+    (*link)->gates = gates;
+    (*link)->exclusive = exclusive;
+    return 1;
+}
+
+/* ---- planning one airport ---- */
+
+typedef struct {
+    SymbolID airline;  /* SYMBOL_NONE = common pool */
+    int exclusive;
+    MinHeap free;      /* gate numbers */
+    MinHeap busy;      /* keyed by the minute the gate frees up */
+} GatePool;
+
+/* A movement belongs to date if its flight operates on that day; an overnight
+   arrival lands the day after the flight's departure date */
+static int movesOnDate(const Flight *f, int arrival, int date) {
+    if (date == DATE_NONE) return 1;
+    int overnight = arrival && f->departure >= 0 && f->arrival < f->departure;
+    return flightOperatesOn(f, date - overnight);
+}
+
+static size_t collectMoves(const TimeSlots *slots, int arrival, int date, Movement *out) {
+    size_t n = 0;
+    for (size_t i = 0; i < slots->count; ++i) {
+        FlightNode *fnode = slots->items[i].fnode;
+        if (!movesOnDate(&fnode->flight, arrival, date)) continue;
+        if (out) {
+            Movement *m = &out[n];
+            memset(m, 0, sizeof(*m));
+            m->fnode = fnode;
+            m->arrival = arrival;
+            m->scheduled = slots->items[i].minutes;
+        }
+        n++;
+    }
+    return n;
+}
+
+/* Ordering used by both sweeps: key, then arrivals first, then flight id */
+static int moveBefore(const Movement *a, int keyA, const Movement *b, int keyB) {
+    if (keyA != keyB) return keyA < keyB;
+    if (a->arrival != b->arrival) return a->arrival;
+    return a->fnode->flight.id < b->fnode->flight.id;
+}
+
+/* Arrivals [0, arrivals) and departures [arrivals, count) are each already in
+   order for either key, so one linear merge gives the sweep order */
+static void mergeOrder(const Movement *moves, size_t arrivals, size_t count, int byGate, size_t *order) {
+    size_t a = 0, d = arrivals, n = 0;
+    while (a < arrivals || d < count) {
+        int takeArrival = d >= count;
+        if (a < arrivals && d < count) {
+            int keyA = byGate ? moves[a].gateFrom : moves[a].scheduled;
+            int keyD = byGate ? moves[d].gateFrom : moves[d].scheduled;
+            takeArrival = moveBefore(&moves[a], keyA, &moves[d], keyD);
+        }
+        order[n++] = takeArrival ? a++ : d++;
+    }
+}
+
+static void assignGates(AirportAlloc *a, GatePool *pools, int poolCount, const size_t *order) {
+    int inUse = 0;
+    for (size_t i = 0; i < a->count; ++i) {
+        Movement *m = &a->moves[order[i]];
+        /* gates whose interval has ended are free again: [from, to) intervals */
+        for (int p = 0; p < poolCount; ++p) {
+            MinHeap *busy = &pools[p].busy;
+            while (busy->count && busy->items[0].key <= m->gateFrom) {
+                HeapItem gate = heapPop(busy);
+                gate.key = gate.id;
+                heapPush(&pools[p].free, gate);
+                inUse--;
+            }
+        }
+        /* the airline's reserved pool first, then the common pool (pools[0]) */
+        SymbolID airline = m->fnode->flight.airline;
+        GatePool *chosen = NULL;
+        int common = 1;
+        for (int p = 1; p < poolCount; ++p) {
+            if (pools[p].airline != airline) continue;
+            if (pools[p].free.count) chosen = &pools[p];
+            common = !pools[p].exclusive;
+            break;
+        }
+        if (!chosen && common && pools[0].free.count) chosen = &pools[0];
+        if (!chosen) {
+            a->ungated++;
+            continue;
+        }
+        HeapItem gate = heapPop(&chosen->free);
+        m->gate = gate.id;
+        gate.key = m->gateTo;
+        heapPush(&chosen->busy, gate);
+        if (++inUse > a->peakGates) a->peakGates = inUse;
+    }
+}
+
+static void assignRunways(AirportAlloc *a, const AllocRules *rules, MinHeap *runways) {
+    runways->count = 0;
+    for (int r = 1; r <= rules->runways; ++r) {
+        HeapItem item = { 0, r };
+        heapPush(runways, item);
+    }
+    for (size_t i = 0; i < a->count; ++i) {
+        Movement *m = &a->moves[a->order[i]];
+        HeapItem runway = heapPop(runways);
+        m->runway = runway.id;
+        m->slot = runway.key > m->scheduled ? runway.key : m->scheduled;
+        if (m->slot - m->scheduled > a->maxWait) a->maxWait = m->slot - m->scheduled;
+        runway.key = m->slot + rules->runwaySlot;
+        heapPush(runways, runway);
+    }
+}
+
+/* The rule r governs its airline at airport: an airport's own rule for an airline
+   overrides that airline's every-airport rule, so each airline has one pool */
+static int ruleApplies(const Allocation *alloc, const GateRule *r, SymbolID airport) {
+    if (r->airport == airport) return 1;
+    if (r->airport != SYMBOL_NONE) return 0;
+    for (const GateRule *o = alloc->gateRules; o; o = o->next) {
+        if (o->airport == airport && o->airline == r->airline) return 0;
+    }
+    return 1;
+}
+
+/* Gate pools for one airport: pools[0] is the common pool, then one per
+   airline with a rule that applies here. Gate numbers run common gates first. */
+static GatePool* buildPools(const Allocation *alloc, SymbolID airport, int *poolCount,
+                            int *gateCount, HeapItem **storage) {
+    int pools = 1, gates = alloc->rules.gates;
+    for (const GateRule *r = alloc->gateRules; r; r = r->next) {
+        if (!ruleApplies(alloc, r, airport)) continue;
+        pools++;
+        gates += r->gates;
+    }
+    GatePool *out = (GatePool*)calloc((size_t)pools, sizeof(GatePool));
+    /* each gate sits in exactly one of its pool's two heaps */
+    HeapItem *items = (HeapItem*)malloc(sizeof(HeapItem) * (2 * (size_t)gates + 1));
+    if (!out || !items) {
+        free(out);
+        free(items);
+        return NULL;
+    }
+    int p = 0, next = 1;
+    size_t used = 0;
+    for (const GateRule *r = NULL; p < pools; ++p) {
+        int size = alloc->rules.gates;
+        out[p].airline = SYMBOL_NONE;
+        if (p > 0) {
+            /* next rule that applies here */
+            r = r ? r->next : alloc->gateRules;
+            while (!ruleApplies(alloc, r, airport)) r = r->next;
+            out[p].airline = r->airline;
+            out[p].exclusive = r->exclusive;
+            size = r->gates;
+        }
+        out[p].free.items = items + used;
+        out[p].busy.items = items + used + (size_t)size;
+        used += 2 * (size_t)size;
+        /* ascending gate numbers already form a valid heap */
+        for (int g = 0; g < size; ++g) {
+            out[p].free.items[g].key = next;
+            out[p].free.items[g].id = next;
+            next++;
+        }
+        out[p].free.count = (size_t)size;
+    }
+    *poolCount = pools;
+    *gateCount = gates;
+    *storage = items;
+    return out;
+}
+
+static void resetPlan(AirportAlloc *a) {
+    free(a->moves);
+    free(a->order);
+    a->moves = NULL;
+    a->order = NULL;
+    a->count = 0;
+    a->gateCount = 0;
+    a->peakGates = 0;
+    a->ungated = 0;
+    a->maxWait = 0;
+}
+
+static int planAirport(const Allocation *alloc, AirportAlloc *a, const AirportTimes *t) {
+    resetPlan(a);
+    if (!t) return 1;
+    const AllocRules *rules = &alloc->rules;
+    size_t arrivals = collectMoves(&t->arrivals, 1, alloc->date, NULL);
+    size_t count = arrivals + collectMoves(&t->departures, 0, alloc->date, NULL);
+    int poolCount = 0, gateCount = 0;
+    HeapItem *poolItems = NULL;
+    GatePool *pools = buildPools(alloc, a->name, &poolCount, &gateCount, &poolItems);
+    size_t *gateOrder = (size_t*)malloc(sizeof(size_t) * (count + 1));
+    HeapItem *runwayItems = (HeapItem*)malloc(sizeof(HeapItem) * ((size_t)rules->runways + 1));
+    a->moves = (Movement*)malloc(sizeof(Movement) * (count + 1));
+    a->order = (size_t*)malloc(sizeof(size_t) * (count + 1));
+    int ok = pools && gateOrder && runwayItems && a->moves && a->order;
+    if (ok) {
+        collectMoves(&t->arrivals, 1, alloc->date, a->moves);
+        collectMoves(&t->departures, 0, alloc->date, a->moves + arrivals);
+        a->count = count;
+        a->gateCount = gateCount;
+        for (size_t i = 0; i < count; ++i) {
+            Movement *m = &a->moves[i];
+            m->gateFrom = m->arrival ? m->scheduled : m->scheduled - rules->boardingLead;
+            m->gateTo = m->arrival ? m->scheduled + rules->turnaround : m->scheduled;
+        }
+        mergeOrder(a->moves, arrivals, count, 1, gateOrder);
+        mergeOrder(a->moves, arrivals, count, 0, a->order);
+        assignGates(a, pools, poolCount, gateOrder);
+        if (rules->runways > 0) {
+            MinHeap runways = { runwayItems, 0 };
+            assignRunways(a, rules, &runways);
+        }
+    } else {
+        resetPlan(a);
+    }
+    free(pools);
+    free(poolItems);
+    free(gateOrder);
+    free(runwayItems);
+    return ok;
+}
+
+static const AirportTimes* airportTimes(const TimeIndex *times, SymbolID airport) {
+    if (airport >= times->symbolSlots) return NULL;
+    return times->bySymbol[airport];
+}
+
+int buildAllocation(Allocation *alloc, const TimeIndex *times, int date) {
+    clearPlans(alloc);
+    alloc->date = date;
+    for (const AirportTimes *t = times->airports; t; t = t->next) {
+        AirportAlloc *a = createAirportAlloc(alloc, t->name);
+        if (!a || !planAirport(alloc, a, t)) {
+            clearPlans(alloc);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int reallocateAirport(Allocation *alloc, const TimeIndex *times, SymbolID airport) {
+    if (airport == SYMBOL_NONE) return 1;
+    AirportAlloc *a = findAirportAlloc(alloc, airport);
+    if (!a) a = createAirportAlloc(alloc, airport);
+    if (!a) return 0;
+    return planAirport(alloc, a, airportTimes(times, airport));
+}
+
+/* Minutes outside 0..1439 (gate intervals across midnight) shown on the clock */
+static const char* formatClock(int minutes, char buf[6]) {
+    return formatTime(((minutes % MINUTES_PER_DAY) + MINUTES_PER_DAY) % MINUTES_PER_DAY, buf);
+}
+
+size_t printAllocation(const Allocation *alloc, const char *airport) {
+    const AirportAlloc *a = findAirportAlloc(alloc, lookupSymbol(airport));
+    if (!a || !a->count) {
+        printf("No movements at %s.\n", airport);
+        return 0;
+    }
+    char day[11];
+    printf("Gate & runway plan for %s (%s): %zu movements, %d gates, %d runways\n",
+           symbolName(a->name), alloc->date == DATE_NONE ? "every flight" : formatDate(alloc->date, day),
+           a->count, a->gateCount, alloc->rules.runways);
+    char sched[6], from[6], to[6], slot[6];
+    for (size_t i = 0; i < a->count; ++i) {
+        const Movement *m = &a->moves[a->order[i]];
+        const Flight *f = &m->fnode->flight;
+        printf("%s %s | Flight %d | %s | ", formatClock(m->scheduled, sched), m->arrival ? "ARR" : "DEP",
+               f->id, symbolName(f->airline));
+        if (m->gate) printf("Gate %d %s-%s", m->gate, formatClock(m->gateFrom, from), formatClock(m->gateTo, to));
+        else printf("NO GATE FREE");
+        if (m->runway) {
+            printf(" | Runway %d at %s", m->runway, formatClock(m->slot, slot));
+            if (m->slot > m->scheduled) printf(" (+%d min)", m->slot - m->scheduled);
+        }
+        printf("\n");
+    }
+    printf("Peak %d of %d gates in use; %zu without a gate; longest runway wait %d min.\n",
+           a->peakGates, a->gateCount, a->ungated, a->maxWait);
+    return a->count;
+}
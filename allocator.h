@@ -0,0 +1,87 @@
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <stddef.h>
+#include "flight.h"
+#include "timeindex.h"
+
+/* Resource rules (minutes / counts, per airport) */
+typedef struct {
+    int turnaround;    /* a gate stays occupied this long after an arrival */
+    int boardingLead;  /* a gate is occupied this long before a departure */
+    int runwaySlot;    /* a runway is held this long by one movement */
+    int runways;       /* runways, shared by arrivals and departures */
+    int gates;         /* common-use gates */
+} AllocRules;
+
+#define DEFAULT_TURNAROUND 30
+#define DEFAULT_BOARDING_LEAD 40
+#define DEFAULT_RUNWAY_SLOT 2
+#define DEFAULT_RUNWAYS 2
+#define DEFAULT_GATES 20
+
+/* Gates reserved for one airline, in addition to the common pool.
+   Rules stored in a linked list. */
+typedef struct GateRule {
+    SymbolID airport;   /* SYMBOL_NONE = every airport */
+    SymbolID airline;
+    int gates;
+    int exclusive;      /* 1 = the airline may not overflow to common gates */
+    struct GateRule *next;
+} GateRule;
+
+/* One arrival or departure at an airport and what it was given */
+typedef struct {
+    FlightNode *fnode;  /* borrowed pointer into the flight list */
+    int arrival;        /* 1 = arrival at this airport, 0 = departure */
+    int scheduled;      /* scheduled minute of the movement */
+    int gate;           /* 1-based gate number, 0 = no gate was free */
+    int gateFrom;       /* gate held over [gateFrom, gateTo); may run past either midnight */
+    int gateTo;
+    int runway;         /* 1-based runway number */
+    int slot;           /* runway minute given (scheduled + wait) */
+} Movement;
+
+typedef struct AirportAlloc {
+    SymbolID name;
+    Movement *moves;    /* arrivals, then departures, each in time order */
+    size_t count;
+    size_t *order;      /* moves by runway time (the printed order) */
+    int gateCount;      /* common + reserved gates at this airport */
+    int peakGates;      /* most gates in use at once */
+    size_t ungated;     /* movements that found no free gate */
+    int maxWait;        /* longest wait for a runway slot */
+    struct AirportAlloc *next;
+} AirportAlloc;
+
+typedef struct {
+    AllocRules rules;
+    GateRule *gateRules;
+    int date;                 /* day planned (DATE_NONE = every flight, one generic day) */
+    AirportAlloc *airports;
+    AirportAlloc **bySymbol;  /* airport lookup by SymbolID (NULL = no entry) */
+    uint32_t symbolSlots;     /* length of bySymbol */
+} Allocation;
+
+void initAllocation(Allocation *alloc, AllocRules rules);
+/* Frees the plan and the gate rules */
+void freeAllocation(Allocation *alloc);
+
+/* Reserve gates for an airline at an airport (SYMBOL_NONE = every airport), replacing
+   an earlier rule for the same pair; gates <= 0 removes it. At an airport with its
+   own rule for the airline, that rule is used instead of the every-airport one. Returns 0 on allocation
+   failure. Call buildAllocation or reallocateAirport afterwards. */
+int setGateRule(Allocation *alloc, SymbolID airport, SymbolID airline, int gates, int exclusive);
+
+/* Plan every airport in the time index for date (DATE_NONE = all flights).
+   Returns 1 on success, 0 on allocation failure (plan left empty). */
+int buildAllocation(Allocation *alloc, const TimeIndex *times, int date);
+/* Re-plan a single airport from the time index after one of its flights was added,
+   deleted or retimed; until then its plan may still point at a deleted flight.
+   Returns 1 on success, 0 on allocation failure (that airport is left empty). */
+int reallocateAirport(Allocation *alloc, const TimeIndex *times, SymbolID airport);
+
+/* Print the plan of one airport; returns the number of movements printed */
+size_t printAllocation(const Allocation *alloc, const char *airport);
+
+#endif
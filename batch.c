@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "batch.h"
+
+void initBatch(FlightBatch *batch) {
+    memset(batch, 0, sizeof(*batch));
+}
+
+int batchAddFlight(FlightBatch *batch, Flight flight) {
+    if (batch->insertCount == batch->insertCapacity) {
+        size_t cap = batch->insertCapacity ? batch->insertCapacity * 2 : 16;
+        Flight *items = (Flight*)realloc(batch->inserts, cap * sizeof(Flight));
+        if (!items) return 0;
+        batch->inserts = items;
+        batch->insertCapacity = cap;
+    }
+    batch->inserts[batch->insertCount++] = flight;
+    return 1;
+}
+
+int batchDeleteFlight(FlightBatch *batch, int id) {
+    if (batch->deleteCount == batch->deleteCapacity) {
+        size_t cap = batch->deleteCapacity ? batch->deleteCapacity * 2 : 16;
+        int *items = (int*)realloc(batch->deletes, cap * sizeof(int));
+        if (!items) return 0;
+        batch->deletes = items;
+        batch->deleteCapacity = cap;
+    }
+    batch->deletes[batch->deleteCount++] = id;
+    return 1;
+}
+
+void freeBatch(FlightBatch *batch) {
+    free(batch->inserts);
+    free(batch->deletes);
+    initBatch(batch);
+}
+
+static int compareInts(const void *a, const void *b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static int containsInt(const int *sorted, size_t count, int value) {
+    return bsearch(&value, sorted, count, sizeof(int), compareInts) != NULL;
+}
+
+/* Binary search over nodes sorted by ID */
+static FlightNode* findNode(FlightNode **sorted, size_t count, int id) {
+    size_t lo = 0, hi = count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int cur = sorted[mid]->flight.id;
+        if (cur == id) return sorted[mid];
+        if (cur < id) lo = mid + 1;
+        else hi = mid;
+    }
+    return NULL;
+}
+
+/* Working state for one commit; everything here is owned until the swap */
+typedef struct {
+    FlightNode **existing; /* current list, sorted by ID */
+    size_t existingCount;
+    int *deletes;          /* sorted, de-duplicated */
+    size_t deleteCount;
+    int *explicitIDs;      /* sorted IDs given by the caller */
+    size_t explicitCount;
+    FlightNode **added;    /* new nodes in staging order */
+    FlightNode **merged;   /* survivors + added, sorted by ID */
+    size_t mergedCount;
+} BatchWork;
+
+static void freeWork(BatchWork *w, int freeAddedNodes) {
+    if (freeAddedNodes && w->added) {
+        for (size_t i = 0; w->added[i]; ++i) free(w->added[i]);
+    }
+    free(w->existing);
+    free(w->deletes);
+    free(w->explicitIDs);
+    free(w->added);
+    free(w->merged);
+}
+
+static int validateBatch(const FlightBatch *batch, BatchWork *w) {
+    for (size_t i = 0; i < w->deleteCount; ++i) {
+        if (!findNode(w->existing, w->existingCount, w->deletes[i])) {
+            printf("Batch rolled back: flight %d not found.\n", w->deletes[i]);
+            return 0;
+        }
+    }
+    for (size_t i = 0; i < batch->insertCount; ++i) {
+        if (batch->inserts[i].id > 0) w->explicitIDs[w->explicitCount++] = batch->inserts[i].id;
+    }
+    qsort(w->explicitIDs, w->explicitCount, sizeof(int), compareInts);
+    for (size_t i = 0; i < w->explicitCount; ++i) {
+        int id = w->explicitIDs[i];
+        /* an ID freed by a delete in the same batch may be reused */
+        int taken = findNode(w->existing, w->existingCount, id) && !containsInt(w->deletes, w->deleteCount, id);
+        if (taken || (i > 0 && w->explicitIDs[i - 1] == id)) {
+            printf("Batch rolled back: flight ID %d is not unique.\n", id);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int commitBatch(FlightBatch *batch, FlightNode **head, TreeNode **tree,
+                Airport **graph, TimeIndex *times) {
+    if (!batch || !head || !tree || !graph || !times) return 0;
+    BatchWork w;
+    memset(&w, 0, sizeof(w));
+    for (FlightNode *cur = *head; cur; cur = cur->next) w.existingCount++;
+
+    w.existing = (FlightNode**)malloc(sizeof(FlightNode*) * (w.existingCount + 1));
+    w.deletes = (int*)malloc(sizeof(int) * (batch->deleteCount + 1));
+    w.explicitIDs = (int*)malloc(sizeof(int) * (batch->insertCount + 1));
+    w.added = (FlightNode**)calloc(batch->insertCount + 1, sizeof(FlightNode*));
+    w.merged = (FlightNode**)malloc(sizeof(FlightNode*) * (w.existingCount + batch->insertCount + 1));
+    if (!w.existing || !w.deletes || !w.explicitIDs || !w.added || !w.merged) {
+        printf("Batch rolled back: out of memory.\n");
+        freeWork(&w, 0);
+        return 0;
+    }
+
+    /* snapshot the list sorted by ID; deletes sorted and de-duplicated */
+    size_t n = 0;
+    for (FlightNode *cur = *head; cur; cur = cur->next) w.existing[n++] = cur;
+    if (!sortNodesByID(w.existing, w.existingCount)) {
+        printf("Batch rolled back: out of memory.\n");
+        freeWork(&w, 0);
+        return 0;
+    }
+    if (batch->deleteCount) memcpy(w.deletes, batch->deletes, sizeof(int) * batch->deleteCount);
+    qsort(w.deletes, batch->deleteCount, sizeof(int), compareInts);
+    for (size_t i = 0; i < batch->deleteCount; ++i) {
+        if (i == 0 || w.deletes[i] != w.deletes[w.deleteCount - 1]) w.deletes[w.deleteCount++] = w.deletes[i];
+    }
+
+    if (!validateBatch(batch, &w)) {
+        freeWork(&w, 0);
+        return 0;
+    }
+
+    /* allocate new nodes; auto IDs come after every explicit one. They are counted
+       locally and the global ID counter only moves once the commit cannot fail,
+       so a rolled-back batch does not use up IDs. */
+    int lastID = peekUniqueID(*head) - 1;
+    if (w.explicitCount && w.explicitIDs[w.explicitCount - 1] > lastID) lastID = w.explicitIDs[w.explicitCount - 1];
+    for (size_t i = 0; i < batch->insertCount; ++i) {
+        FlightNode *node = (FlightNode*)malloc(sizeof(FlightNode));
+        if (!node) {
+            printf("Batch rolled back: out of memory.\n");
+            freeWork(&w, 1);
+            return 0;
+        }
+        node->flight = batch->inserts[i];
+        if (node->flight.id <= 0) node->flight.id = ++lastID;
+        node->next = NULL;
+        w.added[i] = node;
+    }
+
+    /* merged = survivors (already sorted, duplicate IDs in list order) + new nodes,
+       sorted by ID; new IDs are unique, so ties stay in list order */
+    for (size_t i = 0; i < w.existingCount; ++i) {
+        if (!containsInt(w.deletes, w.deleteCount, w.existing[i]->flight.id)) w.merged[w.mergedCount++] = w.existing[i];
+    }
+    for (size_t i = 0; i < batch->insertCount; ++i) w.merged[w.mergedCount++] = w.added[i];
+
+    /* build every index before touching the live structures; the graph and time
+       index take every flight, the ID index the first of each duplicate ID */
+    TreeNode *newTree = NULL;
+    Airport *newGraph = NULL;
+    TimeIndex newTimes;
+    initTimeIndex(&newTimes);
+    if (!sortNodesByID(w.merged, w.mergedCount) ||
+        !buildGraphFromArray(&newGraph, w.merged, w.mergedCount) ||
+        !buildTimeIndexFromArray(&newTimes, w.merged, w.mergedCount) ||
+        !buildTreeFromSorted(w.merged, uniqueByID(w.merged, w.mergedCount), &newTree)) {
+        printf("Batch rolled back: out of memory.\n");
+        freeTree(newTree);
+        freeGraph(newGraph);
+        freeTimeIndex(&newTimes);
+        freeWork(&w, 1);
+        return 0;
+    }
+
+    /* commit: nothing below can fail */
+    FlightNode *cur = *head, *prev = NULL;
+    while (cur) {
+        FlightNode *next = cur->next;
+        if (containsInt(w.deletes, w.deleteCount, cur->flight.id)) {
+            if (prev) prev->next = next;
+            else *head = next;
+            free(cur);
+        } else {
+            prev = cur;
+        }
+        cur = next;
+    }
+    for (size_t i = 0; i < batch->insertCount; ++i) {
+        w.added[i]->next = *head;
+        *head = w.added[i];
+    }
+    reserveID(*head, lastID);
+    freeTree(*tree);
+    *tree = newTree;
+    freeGraph(*graph);
+    *graph = newGraph;
+    freeTimeIndex(times);
+    *times = newTimes;
+    freeWork(&w, 0);
+    return 1;
+}
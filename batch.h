@@ -0,0 +1,37 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stddef.h>
+#include "flight.h"
+#include "tree.h"
+#include "graph.h"
+#include "timeindex.h"
+
+/* Staged inserts and deletes applied together by commitBatch.
+   Nothing touches the flight list or indexes until commit. */
+typedef struct {
+    Flight *inserts;
+    size_t insertCount;
+    size_t insertCapacity;
+    int *deletes;
+    size_t deleteCount;
+    size_t deleteCapacity;
+} FlightBatch;
+
+void initBatch(FlightBatch *batch);
+/* Stage a flight; id <= 0 means "assign a fresh ID at commit". Returns 1 on success, 0 on allocation failure. */
+int batchAddFlight(FlightBatch *batch, Flight flight);
+/* Stage deletion of an existing flight ID. Returns 1 on success, 0 on allocation failure. */
+int batchDeleteFlight(FlightBatch *batch, int id);
+void freeBatch(FlightBatch *batch);
+
+/* Apply the whole batch atomically:
+ * - validates up front (deleted IDs must exist, explicit insert IDs must be unique),
+ * - builds the ID index, airport graph and time index once from sorted arrays,
+ * - then swaps them in and updates the flight list.
+ * Returns 1 on commit. On any failure prints the reason, leaves the list and
+ * indexes untouched (rollback) and returns 0. The batch itself is not freed. */
+int commitBatch(FlightBatch *batch, FlightNode **head, TreeNode **tree,
+                Airport **graph, TimeIndex *times);
+
+#endif
@@ -0,0 +1,328 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "delay.h"
+#include "psort.h"
+
+/* Delay model:
+ * - A delay shifts a flight's departure and arrival by the same amount.
+ * - Edge f -> g exists when g leaves f's destination between minConnect and
+ *   maxConnect minutes after f's planned arrival; slack is the spare time.
+ * - If f is late by more than the slack, g is held for up to maxHold minutes
+ *   (which delays g and everything connecting from it); beyond that the
+ *   connection is broken.
+ * Holds only flow downhill (slack >= 0), so delays are settled like a longest-path
+ * Dijkstra: largest first, each flight once. A hold therefore always traces back
+ * to a reported delay; a cycle of connections cannot keep itself held.
+ * Updates only visit flights reachable from the one whose delay changed.
+ */
+
+void initDelayEngine(DelayEngine *engine, DelayRules rules) {
+    memset(engine, 0, sizeof(*engine));
+    engine->rules = rules;
+}
+
+void freeDelayEngine(DelayEngine *engine) {
+    DelayRules rules = engine->rules;
+    free(engine->nodes);
+    free(engine->edges);
+    free(engine->inRefs);
+    free(engine->changed);
+    free(engine->flipped);
+    free(engine->heap);
+    free(engine->stack);
+    initDelayEngine(engine, rules);
+}
+
+static DelayNode* findDelayNode(const DelayEngine *engine, int id) {
+    size_t lo = 0, hi = engine->nodeCount;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int cur = engine->nodes[mid].id;
+        if (cur == id) return &engine->nodes[mid];
+        if (cur < id) lo = mid + 1;
+        else hi = mid;
+    }
+    return NULL;
+}
+
+static int compareByID(const void *a, const void *b) {
+    int x = (*(FlightNode* const*)a)->flight.id;
+    int y = (*(FlightNode* const*)b)->flight.id;
+    return (x > y) - (x < y);
+}
+
+/* Departures that can connect from f's arrival, as at most two spans */
+static int connectionWindow(const DelayEngine *engine, const TimeIndex *times,
+                            const Flight *f, TimeSpan spans[2]) {
+    if (f->arrival < 0) return 0;
+    int from = (f->arrival + engine->rules.minConnect) % MINUTES_PER_DAY;
+    int to = (f->arrival + engine->rules.maxConnect) % MINUTES_PER_DAY;
+    return timeIndexQueryByID(times, f->destination, TIME_DEPARTURES, from, to, spans);
+}
+
+/* ---- update bookkeeping ---- */
+
+static void touchNode(DelayEngine *engine, DelayNode *n) {
+    if (n->touched) return;
+    n->touched = 1;
+    n->before = n->delay;
+    engine->changed[engine->changedCount++] = n;
+}
+
+static void refreshEdge(DelayEngine *engine, DelayEdge *e) {
+    int broken = e->from->delay - e->slack > e->to->delay;
+    if (broken == e->broken) return;
+    if (!e->touched) {
+        e->touched = 1;
+        e->wasBroken = e->broken;
+        engine->flipped[engine->flippedCount++] = e;
+    }
+    if (broken) engine->brokenCount++;
+    else engine->brokenCount--;
+    e->broken = broken;
+}
+
+/* Re-evaluate every connection into and out of n after its delay changed */
+static void refreshEdges(DelayEngine *engine, DelayNode *n) {
+    for (size_t i = 0; i < n->inCount; ++i) refreshEdge(engine, n->in[i]);
+    for (size_t i = 0; i < n->outCount; ++i) refreshEdge(engine, &n->out[i]);
+}
+
+static void clearUpdate(DelayEngine *engine) {
+    for (size_t i = 0; i < engine->changedCount; ++i) {
+        engine->changed[i]->touched = 0;
+        engine->changed[i]->settled = 0;
+    }
+    for (size_t i = 0; i < engine->flippedCount; ++i) engine->flipped[i]->touched = 0;
+    engine->changedCount = 0;
+    engine->flippedCount = 0;
+}
+
+/* Heap order: larger delay first, then lower flight id (deterministic output) */
+static int itemAbove(const DelayItem *a, const DelayItem *b) {
+    if (a->delay != b->delay) return a->delay > b->delay;
+    return a->node->id < b->node->id;
+}
+
+static void pushItem(DelayEngine *engine, DelayNode *n) {
+    DelayItem item = { n->delay, n };
+    size_t i = engine->heapSize++;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!itemAbove(&item, &engine->heap[parent])) break;
+        engine->heap[i] = engine->heap[parent];
+        i = parent;
+    }
+    engine->heap[i] = item;
+}
+
+static DelayItem popItem(DelayEngine *engine) {
+    DelayItem top = engine->heap[0];
+    DelayItem last = engine->heap[--engine->heapSize];
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= engine->heapSize) break;
+        if (child + 1 < engine->heapSize && itemAbove(&engine->heap[child + 1], &engine->heap[child])) child++;
+        if (!itemAbove(&engine->heap[child], &last)) break;
+        engine->heap[i] = engine->heap[child];
+        i = child;
+    }
+    if (engine->heapSize) engine->heap[i] = last;
+    return top;
+}
+
+/* The hold e would force on its onward flight, or 0 if none (or over maxHold) */
+static int holdFor(const DelayEngine *engine, const DelayEdge *e) {
+    int hold = e->from->delay - e->slack;
+    if (hold <= e->to->ownDelay || hold > engine->rules.maxHold) return 0;
+    return hold;
+}
+
+/* Reset n and every flight whose hold came (directly or transitively) from n to
+   its own delay: an onward flight depends on a released one when its delay equals
+   the hold the released flight forced before this update. Holds raised later while
+   settling stay within maxHold, so they never break connections further down. */
+static void releaseHolds(DelayEngine *engine, DelayNode *n) {
+    size_t top = 0;
+    touchNode(engine, n);
+    n->delay = n->ownDelay;
+    engine->stack[top++] = n;
+    while (top) {
+        DelayNode *cur = engine->stack[--top];
+        for (size_t i = 0; i < cur->outCount; ++i) {
+            DelayNode *next = cur->out[i].to;
+            /* touched == already released in this update */
+            if (next->touched || next->delay <= next->ownDelay) continue;
+            if (next->delay != cur->before - cur->out[i].slack) continue; /* held by another */
+            touchNode(engine, next);
+            next->delay = next->ownDelay;
+            engine->stack[top++] = next;
+        }
+    }
+}
+
+/* Recompute the released flights (the changed list) and anything they now hold.
+   Released flights start from their own delay plus holds from flights outside the
+   released set; then the largest tentative delay is settled and relaxes its onward
+   connections. A hold is never larger than the delay causing it, so a settled
+   flight cannot be raised again. */
+static void settleReleased(DelayEngine *engine) {
+    size_t released = engine->changedCount;
+    engine->heapSize = 0;
+    for (size_t i = 0; i < released; ++i) {
+        DelayNode *n = engine->changed[i];
+        for (size_t j = 0; j < n->inCount; ++j) {
+            const DelayEdge *e = n->in[j];
+            if (e->from->touched) continue; /* released too: relaxed when settled */
+            int hold = holdFor(engine, e);
+            if (hold > n->delay) n->delay = hold;
+        }
+        if (n->delay > 0) pushItem(engine, n);
+    }
+    while (engine->heapSize) {
+        DelayItem item = popItem(engine);
+        DelayNode *n = item.node;
+        if (n->settled || item.delay != n->delay) continue; /* stale entry */
+        n->settled = 1;
+        for (size_t i = 0; i < n->outCount; ++i) {
+            DelayEdge *e = &n->out[i];
+            DelayNode *next = e->to;
+            int hold = holdFor(engine, e);
+            if (next->settled || hold <= next->delay) continue;
+            touchNode(engine, next);
+            next->delay = hold;
+            pushItem(engine, next);
+        }
+    }
+    for (size_t i = 0; i < engine->changedCount; ++i) refreshEdges(engine, engine->changed[i]);
+}
+
+int reportDelay(DelayEngine *engine, int flightID, int delayMinutes) {
+    DelayNode *n = findDelayNode(engine, flightID);
+    if (!n) return 0;
+    if (delayMinutes < 0) delayMinutes = 0;
+    clearUpdate(engine);
+    n->ownDelay = delayMinutes;
+    /* growing or shrinking, any hold downstream may have lost its cause */
+    releaseHolds(engine, n);
+    settleReleased(engine);
+    return 1;
+}
+
+int buildDelayEngine(DelayEngine *engine, FlightNode *flights, const TimeIndex *times) {
+    size_t count = 0;
+    FlightNode **fnodes = flightArray(flights, &count);
+    if (!fnodes) return 0;
+    parallelSort(fnodes, count, sizeof(FlightNode*), compareByID);
+
+    DelayEngine fresh;
+    initDelayEngine(&fresh, engine->rules);
+    fresh.nodeCount = count;
+    fresh.nodes = (DelayNode*)calloc(count + 1, sizeof(DelayNode));
+    fresh.changed = (DelayNode**)malloc(sizeof(DelayNode*) * (count + 1));
+    fresh.stack = (DelayNode**)malloc(sizeof(DelayNode*) * (count + 1));
+    if (!fresh.nodes || !fresh.changed || !fresh.stack) {
+        free(fnodes);
+        freeDelayEngine(&fresh);
+        return 0;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        fresh.nodes[i].id = fnodes[i]->flight.id;
+        fresh.nodes[i].fnode = fnodes[i];
+        /* keep delays already reported for flights that survived the rebuild */
+        DelayNode *old = findDelayNode(engine, fnodes[i]->flight.id);
+        if (old) fresh.nodes[i].ownDelay = old->ownDelay;
+    }
+    free(fnodes);
+
+    /* two passes over the connection windows: count, then fill exactly */
+    TimeSpan spans[2];
+    for (size_t i = 0; i < count; ++i) {
+        int n = connectionWindow(&fresh, times, &fresh.nodes[i].fnode->flight, spans);
+        for (int s = 0; s < n; ++s) fresh.edgeCount += spans[s].count;
+    }
+    fresh.edges = (DelayEdge*)calloc(fresh.edgeCount + 1, sizeof(DelayEdge));
+    fresh.inRefs = (DelayEdge**)malloc(sizeof(DelayEdge*) * (fresh.edgeCount + 1));
+    fresh.flipped = (DelayEdge**)malloc(sizeof(DelayEdge*) * (fresh.edgeCount + 1));
+    fresh.heap = (DelayItem*)malloc(sizeof(DelayItem) * (count + fresh.edgeCount + 1));
+    if (!fresh.edges || !fresh.inRefs || !fresh.flipped || !fresh.heap) {
+        freeDelayEngine(&fresh);
+        return 0;
+    }
+    /* out edges: filled flight by flight, so each flight's run is contiguous */
+    size_t used = 0;
+    for (size_t i = 0; i < count; ++i) {
+        DelayNode *from = &fresh.nodes[i];
+        const Flight *f = &from->fnode->flight;
+        from->out = &fresh.edges[used];
+        int n = connectionWindow(&fresh, times, f, spans);
+        for (int s = 0; s < n; ++s) {
+            for (size_t j = 0; j < spans[s].count; ++j) {
+                DelayNode *to = findDelayNode(&fresh, spans[s].items[j].fnode->flight.id);
+                if (!to || to == from) continue;
+                DelayEdge *e = &fresh.edges[used++];
+                int wait = (spans[s].items[j].minutes - f->arrival + MINUTES_PER_DAY) % MINUTES_PER_DAY;
+                e->from = from;
+                e->to = to;
+                e->slack = wait - fresh.rules.minConnect;
+                to->inCount++;
+            }
+        }
+        from->outCount = (size_t)(&fresh.edges[used] - from->out);
+    }
+    fresh.edgeCount = used;
+    /* in edges: counting sort of edge pointers by destination flight */
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        fresh.nodes[i].in = &fresh.inRefs[offset];
+        offset += fresh.nodes[i].inCount;
+        fresh.nodes[i].inCount = 0;
+    }
+    for (size_t i = 0; i < used; ++i) {
+        DelayNode *to = fresh.edges[i].to;
+        to->in[to->inCount++] = &fresh.edges[i];
+    }
+
+    /* replay carried-over delays from a clean state: every flight is "released" */
+    for (size_t i = 0; i < count; ++i) {
+        touchNode(&fresh, &fresh.nodes[i]);
+        fresh.nodes[i].delay = fresh.nodes[i].ownDelay;
+    }
+    settleReleased(&fresh);
+    clearUpdate(&fresh);
+
+    freeDelayEngine(engine);
+    *engine = fresh;
+    return 1;
+}
+
+void printDelayImpact(const DelayEngine *engine) {
+    size_t shown = 0;
+    for (size_t i = 0; i < engine->changedCount; ++i) {
+        const DelayNode *n = engine->changed[i];
+        if (n->delay == n->before) continue;
+        const Flight *f = &n->fnode->flight;
+        printf("Flight %d (%s -> %s): delay %d -> %d min%s\n", f->id,
+               symbolName(f->source), symbolName(f->destination), n->before, n->delay,
+               n->delay > n->ownDelay ? " (held for connections)" : "");
+        shown++;
+    }
+    for (size_t i = 0; i < engine->flippedCount; ++i) {
+        const DelayEdge *e = engine->flipped[i];
+        if (e->broken == e->wasBroken) continue;
+        const Flight *from = &e->from->fnode->flight;
+        const Flight *to = &e->to->fnode->flight;
+        if (e->broken) {
+            printf("Connection %d -> %d at %s BROKEN (short by %d min)\n", from->id, to->id,
+                   symbolName(from->destination), e->from->delay - e->slack - e->to->delay);
+        } else {
+            printf("Connection %d -> %d at %s restored\n", from->id, to->id,
+                   symbolName(from->destination));
+        }
+        shown++;
+    }
+    if (!shown) printf("No downstream impact.\n");
+    printf("%zu of %zu connections currently broken.\n", engine->brokenCount, engine->edgeCount);
+}
@@ -0,0 +1,83 @@
+#ifndef DELAY_H
+#define DELAY_H
+
+#include <stddef.h>
+#include "flight.h"
+#include "timeindex.h"
+
+/* Connection rules (minutes) */
+typedef struct {
+    int minConnect; /* minimum connection time at the hub */
+    int maxConnect; /* outbound flights departing later than this are not connections */
+    int maxHold;    /* an outbound flight may be held up to this long for an inbound one */
+} DelayRules;
+
+#define DEFAULT_MIN_CONNECT 45
+#define DEFAULT_MAX_CONNECT 360
+#define DEFAULT_MAX_HOLD 30
+
+struct DelayNode;
+
+/* Dependency edge: passengers on `from` connect to `to` at from's destination */
+typedef struct DelayEdge {
+    struct DelayNode *from;
+    struct DelayNode *to;
+    int slack;          /* planned spare minutes beyond the minimum connection time */
+    char broken;        /* 1 if from's current delay makes the connection impossible */
+    char touched;       /* bookkeeping for the current update */
+    char wasBroken;
+} DelayEdge;
+
+typedef struct DelayNode {
+    int id;        /* copied so lookups never touch a (possibly freed) flight node */
+    FlightNode *fnode;
+    int ownDelay;  /* delay reported for this flight */
+    int delay;     /* effective delay: own, or longer if held for a late inbound */
+    int settled;   /* delay is final for the current update */
+    int touched;   /* bookkeeping for the current update */
+    int before;    /* effective delay before the current update */
+    /* edges are stored contiguously per flight so an update walks arrays, not lists */
+    DelayEdge *out;     /* outCount edges leaving this flight */
+    size_t outCount;
+    DelayEdge **in;     /* inCount edges arriving at this flight */
+    size_t inCount;
+} DelayNode;
+
+typedef struct DelayItem {
+    int delay;
+    DelayNode *node;
+} DelayItem;
+
+typedef struct {
+    DelayRules rules;
+    DelayNode *nodes;   /* sorted by flight ID */
+    size_t nodeCount;
+    DelayEdge *edges;   /* grouped by `from` */
+    DelayEdge **inRefs; /* grouped by `to` */
+    size_t edgeCount;
+    size_t brokenCount;
+    /* results of the last update: flights whose delay changed, edges whose status flipped */
+    DelayNode **changed;
+    size_t changedCount;
+    DelayEdge **flipped;
+    size_t flippedCount;
+    /* max-heap of tentative delays; each flight settles once and each edge pushes
+       at most once per update, so nodeCount + edgeCount slots always suffice */
+    DelayItem *heap;
+    size_t heapSize;
+    DelayNode **stack; /* scratch for releasing held flights */
+} DelayEngine;
+
+void initDelayEngine(DelayEngine *engine, DelayRules rules);
+/* Build the inbound -> outbound dependency graph from the time index. Delays already
+   reported for flights that still exist are kept. Returns 1 on success, 0 on allocation failure. */
+int buildDelayEngine(DelayEngine *engine, FlightNode *flights, const TimeIndex *times);
+void freeDelayEngine(DelayEngine *engine);
+
+/* Set the delay (minutes, 0 clears it) of one flight and propagate incrementally to
+   the downstream flights it affects. Returns 1 if the flight is known, 0 otherwise. */
+int reportDelay(DelayEngine *engine, int flightID, int delayMinutes);
+/* Print the flights and connections changed by the last reportDelay */
+void printDelayImpact(const DelayEngine *engine);
+
+#endif
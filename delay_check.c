@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "flight.h"
+#include "timeindex.h"
+#include "delay.h"
+
+/* Standalone check for the incremental delay engine (not part of the menu program).
+ * After every reportDelay the incremental state must equal a full rebuild from the
+ * same reported delays: every flight's effective delay, every connection's broken
+ * flag and the broken count. Run it after changing releaseHolds / settleReleased.
+ * Exits with status 1 if anything differs.
+ */
+
+static unsigned rngState;
+
+/* xorshift: the same networks on every platform */
+static unsigned nextRandom(unsigned bound) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState % bound;
+}
+
+static void addCheckFlight(FlightNode **head, int id, const char *from, const char *to, int dep, int arr) {
+    Flight f;
+    setDailySchedule(&f);
+    f.id = id;
+    f.airline = internSymbol("CHK");
+    f.source = internSymbol(from);
+    f.destination = internSymbol(to);
+    f.departure = (int16_t)dep;
+    f.arrival = (int16_t)arr;
+    f.departureText = SYMBOL_NONE;
+    f.arrivalText = SYMBOL_NONE;
+    addFlight(head, f);
+}
+
+/* Rebuild ref from scratch with engine's reported delays and count the differences */
+static int compareWithRebuild(const DelayEngine *engine, DelayEngine *ref,
+                              FlightNode *flights, const TimeIndex *times) {
+    freeDelayEngine(ref);
+    if (!buildDelayEngine(ref, flights, times)) {
+        printf("Out of memory building the reference engine.\n");
+        exit(2);
+    }
+    for (size_t i = 0; i < ref->nodeCount; ++i) ref->nodes[i].ownDelay = engine->nodes[i].ownDelay;
+    /* a rebuild keeps the reported delays and settles everything again */
+    if (!buildDelayEngine(ref, flights, times)) {
+        printf("Out of memory building the reference engine.\n");
+        exit(2);
+    }
+    int mismatches = 0;
+    for (size_t i = 0; i < engine->nodeCount; ++i) {
+        if (engine->nodes[i].delay != ref->nodes[i].delay) mismatches++;
+    }
+    for (size_t i = 0; i < engine->edgeCount; ++i) {
+        if (engine->edges[i].broken != ref->edges[i].broken) mismatches++;
+    }
+    if (engine->brokenCount != ref->brokenCount) mismatches++;
+    return mismatches;
+}
+
+/* Zero-slack cycle 1 -> 2 -> 3 -> 4 -> 1 fed by flight 5 (minConnect 45, maxHold 30).
+   A 20 minute delay on 5 holds the whole cycle; at 40 minutes the 5 -> 1 connection
+   breaks and the cycle must drop back to on time instead of holding itself. */
+static int checkHeldCycle(DelayRules rules) {
+    FlightNode *flights = NULL;
+    addCheckFlight(&flights, 1, "A", "B", 6 * 60, 7 * 60);
+    addCheckFlight(&flights, 2, "B", "C", 7 * 60 + 45, 8 * 60 + 45);
+    addCheckFlight(&flights, 3, "C", "D", 9 * 60 + 30, 10 * 60 + 30);
+    addCheckFlight(&flights, 4, "D", "A", 11 * 60 + 15, 5 * 60 + 15);
+    addCheckFlight(&flights, 5, "X", "A", 4 * 60, 5 * 60 + 15);
+    TimeIndex times;
+    initTimeIndex(&times);
+    buildTimeIndex(&times, flights);
+    DelayEngine engine, ref;
+    initDelayEngine(&engine, rules);
+    initDelayEngine(&ref, rules);
+    buildDelayEngine(&engine, flights, &times);
+
+    static const int steps[] = { 20, 40, 0 };
+    static const int expected[] = { 20, 0, 0 }; /* delay of flights 1-4 after each step */
+    int failures = 0;
+    for (int s = 0; s < 3; ++s) {
+        reportDelay(&engine, 5, steps[s]);
+        for (size_t i = 0; i < 4; ++i) {
+            if (engine.nodes[i].delay != expected[s]) failures++;
+        }
+        failures += compareWithRebuild(&engine, &ref, flights, &times);
+    }
+    printf("held cycle: %s\n", failures ? "FAILED" : "ok");
+    freeDelayEngine(&engine);
+    freeDelayEngine(&ref);
+    freeTimeIndex(&times);
+    freeFlights(flights);
+    return failures;
+}
+
+/* Random daily networks. Few airports and times on a 15 minute grid give many
+   zero-slack connections and cycles; delays cross maxHold in both directions. */
+static int checkRandomNetwork(DelayRules rules, unsigned seed, int flightCount, int airportCount, int updates) {
+    rngState = seed;
+    FlightNode *flights = NULL;
+    char from[16], to[16];
+    for (int id = 1; id <= flightCount; ++id) {
+        snprintf(from, sizeof(from), "P%u", nextRandom((unsigned)airportCount));
+        snprintf(to, sizeof(to), "P%u", nextRandom((unsigned)airportCount));
+        int dep = (int)nextRandom(96) * 15;
+        int arr = (dep + 30 + (int)nextRandom(20) * 15) % MINUTES_PER_DAY;
+        addCheckFlight(&flights, id, from, to, dep, arr);
+    }
+    TimeIndex times;
+    initTimeIndex(&times);
+    buildTimeIndex(&times, flights);
+    DelayEngine engine, ref;
+    initDelayEngine(&engine, rules);
+    initDelayEngine(&ref, rules);
+    if (!buildDelayEngine(&engine, flights, &times)) {
+        printf("Out of memory building the delay engine.\n");
+        exit(2);
+    }
+
+    int mismatches = 0;
+    for (int u = 0; u < updates; ++u) {
+        int id = 1 + (int)nextRandom((unsigned)flightCount);
+        int delay = nextRandom(4) ? (int)nextRandom(90) : 0;
+        reportDelay(&engine, id, delay);
+        mismatches += compareWithRebuild(&engine, &ref, flights, &times);
+    }
+    printf("seed %u: %d flights, %zu connections, %d updates, %d mismatches\n",
+           seed, flightCount, engine.edgeCount, updates, mismatches);
+    freeDelayEngine(&engine);
+    freeDelayEngine(&ref);
+    freeTimeIndex(&times);
+    freeFlights(flights);
+    return mismatches;
+}
+
+int main(void) {
+    DelayRules rules = { DEFAULT_MIN_CONNECT, DEFAULT_MAX_CONNECT, DEFAULT_MAX_HOLD };
+    int failures = checkHeldCycle(rules);
+    for (unsigned seed = 1; seed <= 20; ++seed) {
+        failures += checkRandomNetwork(rules, seed, 40 + (int)seed * 10, 3 + (int)seed % 5, 300);
+    }
+    failures += checkRandomNetwork(rules, 99, 3000, 40, 40);
+    freeSymbols();
+    printf("%s\n", failures ? "delay_check: FAILED" : "delay_check: all updates match a full rebuild");
+    return failures ? 1 : 0;
+}
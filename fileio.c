@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include "flight.h"
+#include "fileio.h"
+#include "query.h"
 
 void saveFlights(FlightNode *head, const char *filename) {
     FILE *fp = fopen(filename, "w");
@@ -9,50 +11,128 @@ void saveFlights(FlightNode *head, const char *filename) {
         printf("Error opening file for saving: %s\n", filename);
         return;
     }
-    FlightNode *cur = head;
-    while (cur) {
-        fprintf(fp, "%d,%s,%s,%s,%s,%s\n",
-                cur->flight.id,
-                cur->flight.airline,
-                cur->flight.source,
-                cur->flight.destination,
-                cur->flight.departure,
-                cur->flight.arrival);
-        cur = cur->next;
-    }
+    FlightCursor c;
+    cursorAllFlights(&c, head);
+    writeFlights(fp, &c, FORMAT_CSV);
     fclose(fp);
 }
 
+/* Split a CSV line in place into at most max fields. Quoted fields follow RFC 4180
+   ("" inside quotes is one quote), as written by saveFlights and Python's csv module;
+   a quote inside an unquoted field is kept as-is. Returns the number of fields. */
+static int splitCSVLine(char *line, char **fields, int max) {
+    int n = 0;
+    char *p = line;
+    while (n < max) {
+        char *out = p;
+        fields[n++] = out;
+        if (*p == '"') {
+            for (p++; *p; ) {
+                if (*p == '"' && p[1] != '"') {
+                    p++;
+                    break;
+                }
+                if (*p == '"') p++;
+                *out++ = *p++;
+            }
+        }
+        while (*p && *p != ',') *out++ = *p++;
+        int more = *p == ',';
+        *out = '\0';
+        if (!more) break;
+        p++;
+    }
+    return n;
+}
+
+/* A time that is not HH:MM is kept as text so a save writes it back unchanged;
+   blank or "--:--" is simply unknown */
+static void parseTimeField(const char *text, int16_t *minutes, SymbolID *raw) {
+    *minutes = (int16_t)parseTimeMinutes(text);
+    *raw = SYMBOL_NONE;
+    if (*minutes < 0 && text[strspn(text, " ")] != '\0' && strcmp(text, "--:--") != 0) {
+        *minutes = TIME_NONE;
+        *raw = internSymbol(text);
+    }
+}
+
+/* Blank or "-": no restriction */
+static int isOpenField(const char *text) {
+    text += strspn(text, " ");
+    return *text == '\0' || strcmp(text, "-") == 0;
+}
+
+/* Returns 0 if text is neither open nor a valid date */
+static int parseDateField(const char *text, int32_t *date) {
+    if (isOpenField(text)) {
+        *date = DATE_NONE;
+        return 1;
+    }
+    *date = parseDate(text);
+    return *date != DATE_NONE;
+}
+
+/* Split one CSV row into a Flight; names are interned, times packed to minutes.
+   Optional columns 7-9 give the recurring schedule (days, first date, last date;
+   "-" = open); rows without them operate daily.
+   Returns 0 if the row has fewer than six fields, or (with a message) if its
+   schedule is invalid: loading it as a wider schedule would change when it flies.
+   Modifies line. */
+static int parseFlightLine(char *line, Flight *flight) {
+    char *fields[9];
+    int n = splitCSVLine(line, fields, 9);
+    if (n < 6) return 0;
+    flight->id = atoi(fields[0]);
+    setDailySchedule(flight);
+    if (n > 6 && !isOpenField(fields[6])) {
+        int days = parseDays(fields[6]);
+        if (days < 0) {
+            printf("Skipping flight %d: invalid operating days '%s'.\n", flight->id, fields[6]);
+            return 0;
+        }
+        flight->days = (uint8_t)days;
+    }
+    for (int i = 7; i < n && i < 9; ++i) {
+        if (!parseDateField(fields[i], i == 7 ? &flight->validFrom : &flight->validTo)) {
+            printf("Skipping flight %d: invalid date '%s'.\n", flight->id, fields[i]);
+            return 0;
+        }
+    }
+    if (flight->validFrom != DATE_NONE && flight->validTo != DATE_NONE && flight->validTo < flight->validFrom) {
+        printf("Skipping flight %d: last date %s is before first date %s.\n", flight->id, fields[8], fields[7]);
+        return 0;
+    }
+    flight->airline = internSymbol(fields[1]);
+    flight->source = internSymbol(fields[2]);
+    flight->destination = internSymbol(fields[3]);
+    parseTimeField(fields[4], &flight->departure, &flight->departureText);
+    parseTimeField(fields[5], &flight->arrival, &flight->arrivalText);
+    return 1;
+}
+
+/* Lines may be any length */
 void loadFlights(FlightNode **head, const char *filename) {
     FILE *fp = fopen(filename, "r");
     if (!fp) return;
-    char line[512];
-    while (fgets(line, sizeof(line), fp)) {
+    char *line;
+    while ((line = readLine(fp)) != NULL) {
+        Flight flight;
+        if (parseFlightLine(line, &flight)) addFlight(head, flight);
+        free(line);
+    }
+    fclose(fp);
+}
+
+int loadFlightBatch(FlightBatch *batch, const char *filename) {
+    FILE *fp = fopen(filename, "r");
+    if (!fp) return -1;
+    int staged = 0;
+    char *line;
+    while ((line = readLine(fp)) != NULL) {
         Flight flight;
-        char *token = strtok(line, ",");
-        if (!token) continue;
-        flight.id = atoi(token);
-        token = strtok(NULL, ",");
-        if (!token) continue;
-        strncpy(flight.airline, token, sizeof(flight.airline));
-        flight.airline[strcspn(flight.airline, "\n")] = 0;
-        token = strtok(NULL, ",");
-        if (!token) continue;
-        strncpy(flight.source, token, sizeof(flight.source));
-        flight.source[strcspn(flight.source, "\n")] = 0;
-        token = strtok(NULL, ",");
-        if (!token) continue;
-        strncpy(flight.destination, token, sizeof(flight.destination));
-        flight.destination[strcspn(flight.destination, "\n")] = 0;
-        token = strtok(NULL, ",");
-        if (!token) continue;
-        strncpy(flight.departure, token, sizeof(flight.departure));
-        flight.departure[strcspn(flight.departure, "\n")] = 0;
-        token = strtok(NULL, ",");
-        if (!token) continue;
-        strncpy(flight.arrival, token, sizeof(flight.arrival));
-        flight.arrival[strcspn(flight.arrival, "\n")] = 0;
-        addFlight(head, flight);
+        if (parseFlightLine(line, &flight) && batchAddFlight(batch, flight)) staged++;
+        free(line);
     }
     fclose(fp);
-}
\ No newline at end of file
+    return staged;
+}
@@ -2,8 +2,12 @@
 #define FILEIO_H
 
 #include "flight.h"
+#include "batch.h"
 
 void saveFlights(FlightNode *head, const char *filename);
 void loadFlights(FlightNode **head, const char *filename);
+/* Stage every row of a flights CSV as a batch insert (ID 0 = auto-assign).
+   Returns the number of rows staged, or -1 if the file cannot be read. */
+int loadFlightBatch(FlightBatch *batch, const char *filename);
 
 #endif
\ No newline at end of file
@@ -2,45 +2,285 @@
 #include <stdlib.h>
 #include <string.h>
 #include "flight.h"
+#include "query.h"
 
 /* Sequential ID counter:
  * - nextID is initialized on first call to getUniqueID by scanning the existing list
  *   and setting nextID = maxExistingID + 1 (or 1 if list empty).
  * - Each call returns nextID++.
+ * - reserveID bumps nextID past IDs that were assigned explicitly (e.g. batch imports).
  */
+static int nextID = 0;
+
+static void initNextID(FlightNode *head) {
+    if (nextID != 0) return;
+    int max = 0;
+    FlightNode *cur = head;
+    while (cur) {
+        if (cur->flight.id > max) max = cur->flight.id;
+        cur = cur->next;
+    }
+    nextID = (max >= 1) ? (max + 1) : 1;
+}
+
 int getUniqueID(FlightNode *head) {
-    static int nextID = 0;
-    if (nextID == 0) {
-        int max = 0;
-        FlightNode *cur = head;
-        while (cur) {
-            if (cur->flight.id > max) max = cur->flight.id;
-            cur = cur->next;
+    initNextID(head);
+    return nextID++;
+}
+
+int peekUniqueID(FlightNode *head) {
+    initNextID(head);
+    return nextID;
+}
+
+void reserveID(FlightNode *head, int id) {
+    initNextID(head);
+    if (id >= nextID) nextID = id + 1;
+}
+
+int isIDUnique(FlightNode *head, int id) {
+    return searchFlightByID(head, id) == NULL;
+}
+
+/* Accepts "HH:MM", "H:MM", "HHMM" and "HMM" (the data file has a mix of these). */
+int parseTimeMinutes(const char *text) {
+    if (!text) return -1;
+    int digits[4];
+    int n = 0, colon = -1;
+    for (const char *p = text; *p; ++p) {
+        if (*p >= '0' && *p <= '9') {
+            if (n == 4) return -1;
+            digits[n++] = *p - '0';
+        } else if (*p == ':' && colon < 0) {
+            colon = n;
+        } else if (*p != ' ') {
+            return -1;
         }
-        nextID = (max >= 1) ? (max + 1) : 1;
     }
-    return nextID++;
+    if (n < 3) return -1;
+    /* minutes are always the last two digits; colon (if any) must sit right before them */
+    if (colon >= 0 && colon != n - 2) return -1;
+    int hours = (n == 4) ? digits[0] * 10 + digits[1] : digits[0];
+    int mins = digits[n - 2] * 10 + digits[n - 1];
+    if (hours > 23 || mins > 59) return -1;
+    return hours * 60 + mins;
+}
+
+const char* formatTime(int minutes, char buf[6]) {
+    if (minutes < 0 || minutes >= 24 * 60) {
+        strcpy(buf, "--:--");
+    } else {
+        /* digit arithmetic: this runs once per field in bulk listings */
+        int h = minutes / 60, m = minutes % 60;
+        buf[0] = (char)('0' + h / 10);
+        buf[1] = (char)('0' + h % 10);
+        buf[2] = ':';
+        buf[3] = (char)('0' + m / 10);
+        buf[4] = (char)('0' + m % 10);
+        buf[5] = '\0';
+    }
+    return buf;
+}
+
+const char* formatFlightTime(const Flight *flight, int arrival, char buf[6]) {
+    SymbolID text = arrival ? flight->arrivalText : flight->departureText;
+    if (text != SYMBOL_NONE) return symbolName(text);
+    return formatTime(arrival ? flight->arrival : flight->departure, buf);
+}
+
+void setDailySchedule(Flight *flight) {
+    flight->days = ALL_DAYS;
+    flight->validFrom = DATE_NONE;
+    flight->validTo = DATE_NONE;
+}
+
+int isDailySchedule(const Flight *flight) {
+    return flight->days == ALL_DAYS && flight->validFrom == DATE_NONE && flight->validTo == DATE_NONE;
+}
+
+/* Civil-calendar conversions (proleptic Gregorian, era-based so no tables are needed) */
+static int daysFromCivil(int y, int m, int d) {
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+static void civilFromDays(int z, int *y, int *m, int *d) {
+    z += 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int doe = z - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    *d = doy - (153 * mp + 2) / 5 + 1;
+    *m = mp < 10 ? mp + 3 : mp - 9;
+    *y = yoe + era * 400 + (*m <= 2);
+}
+
+int parseDate(const char *text) {
+    int y, m, d;
+    char extra;
+    if (!text || sscanf(text, "%d-%d-%d%c", &y, &m, &d, &extra) != 3) return DATE_NONE;
+    if (y < 1900 || y > 9999 || m < 1 || m > 12 || d < 1 || d > 31) return DATE_NONE;
+    int date = daysFromCivil(y, m, d);
+    /* reject days past the end of the month (e.g. 2026-02-30) */
+    int cy, cm, cd;
+    civilFromDays(date, &cy, &cm, &cd);
+    if (cm != m || cd != d) return DATE_NONE;
+    return date;
+}
+
+const char* formatDate(int date, char buf[11]) {
+    if (date == DATE_NONE) {
+        strcpy(buf, "-");
+        return buf;
+    }
+    int y, m, d;
+    civilFromDays(date, &y, &m, &d);
+    snprintf(buf, 11, "%04d-%02d-%02d", y, m, d);
+    return buf;
+}
+
+int parseDays(const char *text) {
+    int mask = 0;
+    for (const char *p = text; p && *p; ++p) {
+        if (*p >= '1' && *p <= '7') mask |= 1 << (*p - '1');
+        else if (*p != ' ' && *p != '.') return -1; /* SSIM writes "1.3.5.7" style too */
+    }
+    return mask ? mask : -1;
+}
+
+const char* formatDays(unsigned days, char buf[8]) {
+    int n = 0;
+    for (int i = 0; i < 7; ++i) {
+        if (days & (1u << i)) buf[n++] = (char)('1' + i);
+    }
+    buf[n] = '\0';
+    return buf;
+}
+
+int weekdayOf(int date) {
+    /* 1970-01-01 was a Thursday (weekday 3) */
+    int w = (date + 3) % 7;
+    return w < 0 ? w + 7 : w;
+}
+
+int flightOperatesOn(const Flight *flight, int date) {
+    if (date == DATE_NONE) return 1;
+    if (flight->validFrom != DATE_NONE && date < flight->validFrom) return 0;
+    if (flight->validTo != DATE_NONE && date > flight->validTo) return 0;
+    return (flight->days >> weekdayOf(date)) & 1;
+}
+
+int nextOperatingDate(const Flight *flight, int onOrAfter) {
+    if (!(flight->days & ALL_DAYS)) return DATE_NONE;
+    int date = onOrAfter;
+    if (flight->validFrom != DATE_NONE && date < flight->validFrom) date = flight->validFrom;
+    /* at most a week ahead to hit a set weekday */
+    for (int i = 0; i < 7; ++i, ++date) {
+        if (flight->validTo != DATE_NONE && date > flight->validTo) return DATE_NONE;
+        if ((flight->days >> weekdayOf(date)) & 1) return date;
+    }
+    return DATE_NONE;
+}
+
+char* readLine(FILE *fp) {
+    size_t cap = 64, len = 0;
+    char *buf = (char*)malloc(cap);
+    if (!buf) return NULL;
+    int c;
+    while ((c = fgetc(fp)) != EOF && c != '\n') {
+        if (len + 1 == cap) {
+            char *bigger = (char*)realloc(buf, cap * 2);
+            if (!bigger) {
+                free(buf);
+                return NULL;
+            }
+            buf = bigger;
+            cap *= 2;
+        }
+        buf[len++] = (char)c;
+    }
+    if (c == EOF && len == 0) {
+        free(buf);
+        return NULL;
+    }
+    if (len > 0 && buf[len - 1] == '\r') len--;
+    buf[len] = '\0';
+    return buf;
+}
+
+static SymbolID promptSymbol(const char *prompt) {
+    printf("%s", prompt);
+    char *line = readLine(stdin);
+    SymbolID id = internSymbol(line ? line : "");
+    free(line);
+    return id;
+}
+
+/* Re-prompts until a valid date is entered; blank keeps DATE_NONE (open-ended) */
+static int32_t promptDate(const char *prompt) {
+    for (;;) {
+        printf("%s", prompt);
+        char *line = readLine(stdin);
+        if (!line) return DATE_NONE;
+        int blank = line[strspn(line, " ")] == '\0';
+        int date = parseDate(line);
+        free(line);
+        if (blank || date != DATE_NONE) return date;
+        printf("Invalid date. Use YYYY-MM-DD.\n");
+    }
+}
+
+/* Re-prompts until valid day digits are entered; blank means daily */
+static uint8_t promptDays(const char *prompt) {
+    for (;;) {
+        printf("%s", prompt);
+        char *line = readLine(stdin);
+        if (!line) return ALL_DAYS;
+        int blank = line[strspn(line, " ")] == '\0';
+        int days = parseDays(line);
+        free(line);
+        if (blank) return ALL_DAYS;
+        if (days > 0) return (uint8_t)days;
+        printf("Invalid days. Use digits 1-7 (1 = Monday), e.g. 12345.\n");
+    }
+}
+
+/* Re-prompts until a valid time is entered (TIME_NONE on EOF) */
+static int16_t promptTime(const char *prompt) {
+    for (;;) {
+        printf("%s", prompt);
+        char *line = readLine(stdin);
+        if (!line) return TIME_NONE;
+        int minutes = parseTimeMinutes(line);
+        free(line);
+        if (minutes >= 0) return (int16_t)minutes;
+        printf("Invalid time. Use HH:MM.\n");
+    }
 }
 
 Flight inputFlight(void) {
     Flight flight;
     /* ID assigned by caller (main) using getUniqueID */
     flight.id = 0;
-    printf("Enter Airline Name: ");
-    fgets(flight.airline, sizeof(flight.airline), stdin);
-    flight.airline[strcspn(flight.airline, "\n")] = 0;
-    printf("Enter Source (airport name): ");
-    fgets(flight.source, sizeof(flight.source), stdin);
-    flight.source[strcspn(flight.source, "\n")] = 0;
-    printf("Enter Destination (airport name): ");
-    fgets(flight.destination, sizeof(flight.destination), stdin);
-    flight.destination[strcspn(flight.destination, "\n")] = 0;
-    printf("Enter Departure Time (HH:MM): ");
-    fgets(flight.departure, sizeof(flight.departure), stdin);
-    flight.departure[strcspn(flight.departure, "\n")] = 0;
-    printf("Enter Arrival Time (HH:MM): ");
-    fgets(flight.arrival, sizeof(flight.arrival), stdin);
-    flight.arrival[strcspn(flight.arrival, "\n")] = 0;
+    flight.airline = promptSymbol("Enter Airline Name: ");
+    flight.source = promptSymbol("Enter Source (airport name): ");
+    flight.destination = promptSymbol("Enter Destination (airport name): ");
+    flight.departure = promptTime("Enter Departure Time (HH:MM): ");
+    flight.arrival = promptTime("Enter Arrival Time (HH:MM): ");
+    flight.departureText = SYMBOL_NONE;
+    flight.arrivalText = SYMBOL_NONE;
+    flight.days = promptDays("Enter Operating Days (1-7, 1 = Monday; blank = daily): ");
+    flight.validFrom = promptDate("Enter First Date (YYYY-MM-DD; blank = open): ");
+    for (;;) {
+        flight.validTo = promptDate("Enter Last Date (YYYY-MM-DD; blank = open): ");
+        if (flight.validFrom == DATE_NONE || flight.validTo == DATE_NONE || flight.validTo >= flight.validFrom) break;
+        printf("Last date is before the first date.\n");
+    }
     return flight;
 }
 
@@ -65,16 +305,9 @@ FlightNode* searchFlightByID(FlightNode *head, int id) {
 }
 
 void searchFlightByDestination(FlightNode *head, const char *destination) {
-    int found = 0;
-    FlightNode *cur = head;
-    while (cur) {
-        if (strcmp(cur->flight.destination, destination) == 0) {
-            printFlight(&(cur->flight));
-            found = 1;
-        }
-        cur = cur->next;
-    }
-    if (!found) printf("No flights found to destination: %s\n", destination);
+    FlightCursor c;
+    cursorByDestination(&c, head, destination);
+    if (!writeFlights(stdout, &c, FORMAT_TEXT)) printf("No flights found to destination: %s\n", destination);
 }
 
 int deleteFlight(FlightNode **head, int id) {
@@ -93,21 +326,13 @@ int deleteFlight(FlightNode **head, int id) {
 }
 
 void printFlight(const Flight *flight) {
-    printf("ID: %d | Airline: %s | %s -> %s | Dep: %s | Arr: %s\n",
-           flight->id, flight->airline, flight->source, flight->destination,
-           flight->departure, flight->arrival);
+    writeFlight(stdout, flight, FORMAT_TEXT);
 }
 
 void printAllFlights(FlightNode *head) {
-    if (!head) {
-        printf("No flights available.\n");
-        return;
-    }
-    FlightNode *cur = head;
-    while (cur) {
-        printFlight(&(cur->flight));
-        cur = cur->next;
-    }
+    FlightCursor c;
+    cursorAllFlights(&c, head);
+    if (!writeFlights(stdout, &c, FORMAT_TEXT)) printf("No flights available.\n");
 }
 
 void freeFlights(FlightNode *head) {
@@ -117,4 +342,15 @@ void freeFlights(FlightNode *head) {
         cur = cur->next;
         free(tmp);
     }
+}
+
+FlightNode** flightArray(FlightNode *head, size_t *count) {
+    size_t n = 0;
+    for (FlightNode *cur = head; cur; cur = cur->next) n++;
+    FlightNode **nodes = (FlightNode**)malloc(sizeof(FlightNode*) * (n + 1));
+    if (!nodes) return NULL;
+    n = 0;
+    for (FlightNode *cur = head; cur; cur = cur->next) nodes[n++] = cur;
+    *count = n;
+    return nodes;
 }
\ No newline at end of file
@@ -2,14 +2,35 @@
 #define FLIGHT_H
 
 #include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "symtab.h"
 
+/* Times are packed as minutes since midnight (0..1439); TIME_NONE if unknown */
+#define TIME_NONE ((int16_t)-1)
+
+/* Dates are days since 1970-01-01; DATE_NONE means "no bound" / "any date" */
+#define DATE_NONE INT32_MIN
+/* Operating-day mask: bit 0 = Monday ... bit 6 = Sunday */
+#define ALL_DAYS 0x7F
+
+/* A Flight is a recurring schedule: it operates on every date in
+   [validFrom, validTo] whose weekday is set in days. Individual dated
+   instances are never stored; they are checked on demand. */
 typedef struct {
     int id;
-    char airline[32];
-    char source[32];
-    char destination[32];
-    char departure[16];
-    char arrival[16];
+    SymbolID airline;
+    SymbolID source;
+    SymbolID destination;
+    int16_t departure;
+    int16_t arrival;
+    /* Original text of a time that is not HH:MM (e.g. "TBD"), kept so saving writes
+       it back unchanged; SYMBOL_NONE otherwise. Such a time is TIME_NONE above. */
+    SymbolID departureText;
+    SymbolID arrivalText;
+    uint8_t days;
+    int32_t validFrom;
+    int32_t validTo;
 } Flight;
 
 typedef struct FlightNode {
@@ -26,9 +47,45 @@ int deleteFlight(FlightNode **head, int id);
 void printFlight(const Flight *flight);
 void printAllFlights(FlightNode *head);
 void freeFlights(FlightNode *head);
+/* Gather the list into a malloc'd array of node pointers (list order) for bulk
+   index construction. Stores the length in *count; returns NULL on allocation failure. */
+FlightNode** flightArray(FlightNode *head, size_t *count);
 
 /* ID helpers */
 int isIDUnique(FlightNode *head, int id);
 int getUniqueID(FlightNode *head);
+int peekUniqueID(FlightNode *head); /* what getUniqueID would return, without using it */
+void reserveID(FlightNode *head, int id); /* keep getUniqueID from handing out id again */
+
+/* Time helpers: parse "HH:MM" or "HHMM" into minutes since midnight.
+   Returns -1 if the string is not a valid time of day. */
+int parseTimeMinutes(const char *text);
+/* Format packed minutes as "HH:MM" ("--:--" for TIME_NONE); buf needs 6 bytes */
+const char* formatTime(int minutes, char buf[6]);
+/* A flight's departure (arrival = 0) or arrival time as written: HH:MM, the kept
+   original text, or "--:--"; buf needs 6 bytes */
+const char* formatFlightTime(const Flight *flight, int arrival, char buf[6]);
+
+/* Schedule helpers */
+void setDailySchedule(Flight *flight);      /* every day, no date bounds */
+int isDailySchedule(const Flight *flight);
+/* Parse "YYYY-MM-DD" into days since 1970-01-01 (DATE_NONE if invalid) */
+int parseDate(const char *text);
+/* Format a date as "YYYY-MM-DD" ("-" for DATE_NONE); buf needs 11 bytes */
+const char* formatDate(int date, char buf[11]);
+/* Parse operating days written as IATA day digits ("12345" = Mon-Fri, "1234567" = daily).
+   Returns the mask, or -1 if invalid. */
+int parseDays(const char *text);
+/* Format a mask as day digits; buf needs 8 bytes */
+const char* formatDays(unsigned days, char buf[8]);
+int weekdayOf(int date);                    /* 0 = Monday ... 6 = Sunday */
+/* 1 if the schedule has an instance on date (DATE_NONE matches any date) */
+int flightOperatesOn(const Flight *flight, int date);
+/* First date >= onOrAfter with an instance, or DATE_NONE if the schedule has ended */
+int nextOperatingDate(const Flight *flight, int onOrAfter);
+
+/* Read one line of any length without the trailing newline.
+   Returns a malloc'd string the caller frees, or NULL on EOF. */
+char* readLine(FILE *fp);
 
 #endif
\ No newline at end of file
@@ -1,29 +1,32 @@
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "graph.h"
+#include "psort.h"
 
 /* Helper: find airport by name */
-static Airport* findAirport(Airport *head, const char *name) {
+static Airport* findAirport(Airport *head, SymbolID name) {
     Airport *cur = head;
     while (cur) {
-        if (strcmp(cur->name, name) == 0) return cur;
+        if (cur->name == name) return cur;
         cur = cur->next;
     }
     return NULL;
 }
 
 /* Create and prepend airport node */
-static Airport* createAirport(Airport **head, const char *name) {
+static Airport* createAirport(Airport **head, SymbolID name) {
     Airport *a = (Airport*)malloc(sizeof(Airport));
     if (!a) return NULL;
-    strncpy(a->name, name, sizeof(a->name));
-    a->name[sizeof(a->name)-1] = '\0';
+    a->name = name;
     a->adj = NULL;
     a->next = *head;
     a->visited = 0;
     a->parent = NULL;
     a->parentFlight = NULL;
+    a->bestArrival = LLONG_MAX;
+    a->label = NULL;
     *head = a;
     return a;
 }
@@ -39,20 +42,68 @@ static int addAdjFlight(Airport *src, FlightNode *fnode) {
     return 1;
 }
 
-/* Build graph from flight list */
+/* Build graph from flight list (bulk, sort-based) */
 void buildGraph(Airport **head, FlightNode *flights) {
     if (!head) return;
     freeGraph(*head);
     *head = NULL;
-    FlightNode *f = flights;
-    while (f) {
-        Airport *src = findAirport(*head, f->flight.source);
-        if (!src) src = createAirport(head, f->flight.source);
-        Airport *dst = findAirport(*head, f->flight.destination);
-        if (!dst) dst = createAirport(head, f->flight.destination);
-        addAdjFlight(src, f);
-        f = f->next;
+    size_t count = 0;
+    FlightNode **nodes = flightArray(flights, &count);
+    if (!nodes || !buildGraphFromArray(head, nodes, count)) {
+        fprintf(stderr, "Memory allocation failed while building airport graph.\n");
     }
+    free(nodes);
+}
+
+/* Order by source airport, then flight ID, so each airport's flights form one run */
+static int compareBySource(const void *a, const void *b) {
+    const Flight *fa = &(*(FlightNode* const*)a)->flight;
+    const Flight *fb = &(*(FlightNode* const*)b)->flight;
+    if (fa->source != fb->source) return fa->source < fb->source ? -1 : 1;
+    if (fa->id != fb->id) return fa->id < fb->id ? -1 : 1;
+    return 0;
+}
+
+/* Airports are looked up through a table indexed by symbol ID instead of
+   scanning the airport list, and each source's adjacency is emitted in one pass. */
+int buildGraphFromArray(Airport **out, FlightNode **nodes, size_t count) {
+    if (!out) return 0;
+    Airport *head = NULL;
+    Airport **bySymbol = (Airport**)calloc(symbolCount() + 1, sizeof(Airport*));
+    FlightNode **sorted = (FlightNode**)malloc(sizeof(FlightNode*) * (count ? count : 1));
+    if (!bySymbol || !sorted) {
+        free(bySymbol);
+        free(sorted);
+        return 0;
+    }
+    memcpy(sorted, nodes, sizeof(FlightNode*) * count);
+    parallelSort(sorted, count, sizeof(FlightNode*), compareBySource);
+
+    int ok = 1;
+    for (size_t i = 0; i < count && ok; ++i) {
+        SymbolID ends[2] = { sorted[i]->flight.source, sorted[i]->flight.destination };
+        for (int e = 0; e < 2 && ok; ++e) {
+            if (ends[e] >= symbolCount()) continue;
+            if (!bySymbol[ends[e]]) {
+                bySymbol[ends[e]] = createAirport(&head, ends[e]);
+                if (!bySymbol[ends[e]]) ok = 0;
+            }
+        }
+    }
+    /* walk each run backwards so prepending leaves adjacency in ascending ID order */
+    for (size_t i = count; i > 0 && ok; --i) {
+        FlightNode *f = sorted[i - 1];
+        if (f->flight.source >= symbolCount()) continue;
+        if (!addAdjFlight(bySymbol[f->flight.source], f)) ok = 0;
+    }
+    free(bySymbol);
+    free(sorted);
+    if (!ok) {
+        freeGraph(head);
+        return 0;
+    }
+    *out = head;
+    return 1;
 }
 
 /* Free graph (adj lists and airport nodes). Does not free FlightNode list. */
@@ -104,24 +155,26 @@ static void resetBFSFields(Airport *head) {
         cur->visited = 0;
         cur->parent = NULL;
         cur->parentFlight = NULL;
+        cur->bestArrival = LLONG_MAX;
+        cur->label = NULL;
         cur = cur->next;
     }
 }
 
-/* BFS to find shortest-hop itinerary */
-int findItinerary(Airport *airportHead, const char *src, const char *dest, int maxStops) {
-    if (!airportHead || !src || !dest) return 0;
-    Airport *start = findAirport(airportHead, src);
-    Airport *goal = findAirport(airportHead, dest);
-    if (!start) {
-        printf("Source airport '%s' not found.\n", src);
-        return 0;
-    }
-    if (!goal) {
-        printf("Destination airport '%s' not found.\n", dest);
-        return 0;
-    }
-    resetBFSFields(airportHead);
+/* Days from reaching an airport on `prev` to `leg` departing: the connection waits
+   overnight when the leg leaves earlier on the clock than prev lands */
+static int connectionDays(const Flight *prev, const Flight *leg) {
+    if (!prev || prev->arrival < 0 || leg->departure < 0) return 0;
+    return leg->departure < prev->arrival;
+}
+
+/* Days the leg itself spends in the air past midnight */
+static int overnightDays(const Flight *leg) {
+    return leg->arrival >= 0 && leg->departure >= 0 && leg->arrival < leg->departure;
+}
+
+/* Undated search: plain BFS over airports, every flight usable */
+static int searchUndated(Airport *airportHead, Airport *start, Airport *goal, int maxStops) {
     BFSQ *front = NULL, *rear = NULL;
     bfs_enqueue(&front, &rear, start, 0);
     start->visited = 1;
@@ -133,7 +186,7 @@ int findItinerary(Airport *airportHead, const char *src, const char *dest, int m
         Airport *curA = node->airport;
         int depth = node->depth;
         free(node);
-        if (strcmp(curA->name, dest) == 0) {
+        if (curA == goal) {
             found = 1;
             break;
         }
@@ -151,52 +204,182 @@ int findItinerary(Airport *airportHead, const char *src, const char *dest, int m
             }
         }
     }
+    /* clear remaining queue nodes */
+    while (front) {
+        BFSQ *n = bfs_dequeue(&front, &rear);
+        free(n);
+    }
+    return found;
+}
+
+/* Dated search state: the earliest arrival at an airport using exactly `layer` legs */
+typedef struct ArrivalLabel {
+    Airport *airport;
+    FlightNode *flight;          /* leg that got here; NULL for the start */
+    struct ArrivalLabel *parent;
+    int date;                    /* date the leg was flown */
+    int arrivalDay;              /* days after the travel date it lands */
+    int layer;
+    struct ArrivalLabel *nextInLayer;
+    struct ArrivalLabel *nextAll; /* every label, for freeing */
+} ArrivalLabel;
+
+static ArrivalLabel* newLabel(ArrivalLabel **all, Airport *airport, int layer) {
+    ArrivalLabel *l = (ArrivalLabel*)calloc(1, sizeof(ArrivalLabel));
+    if (!l) return NULL;
+    l->airport = airport;
+    l->layer = layer;
+    l->nextAll = *all;
+    *all = l;
+    return l;
+}
 
-    if (!found) {
-        printf("No itinerary found from '%s' to '%s' within %d stops.\n", src, dest, maxStops);
-        /* clear queue nodes */
-        while (front) {
-            BFSQ *n = bfs_dequeue(&front, &rear);
-            free(n);
+/* Dated search, one hop layer at a time. Arriving earlier never rules out a later
+   leg (a connection may wait for the leg's next operating day), so each airport
+   only keeps a label that beats every earlier arrival there, from this or any
+   previous layer. The first layer that reaches the goal has the fewest legs.
+   Returns the goal's label (or NULL); *noMemory is set on allocation failure. */
+static ArrivalLabel* searchDated(Airport *airportHead, Airport *start, Airport *goal,
+                                 int maxStops, int date, ArrivalLabel **all, int *noMemory) {
+    ArrivalLabel *layer = newLabel(all, start, 0);
+    if (!layer) {
+        *noMemory = 1;
+        return NULL;
+    }
+    layer->date = date;
+    for (int k = 1; k <= maxStops + 1 && layer && !goal->label; ++k) {
+        ArrivalLabel *next = NULL, **tail = &next;
+        for (ArrivalLabel *cur = layer; cur; cur = cur->nextInLayer) {
+            for (AdjFlight *af = cur->airport->adj; af; af = af->next) {
+                const Flight *f = &af->fnode->flight;
+                int legDate;
+                if (!cur->flight) {
+                    /* the first leg leaves on the travel date itself */
+                    legDate = flightOperatesOn(f, date) ? date : DATE_NONE;
+                } else {
+                    legDate = nextOperatingDate(f, date + cur->arrivalDay + connectionDays(&cur->flight->flight, f));
+                }
+                if (legDate == DATE_NONE) continue;
+                Airport *neighbor = findAirport(airportHead, f->destination);
+                if (!neighbor) continue;
+                int arrivalDay = legDate - date + overnightDays(f);
+                /* an unknown arrival time counts as midnight, matching connectionDays */
+                long long arrival = arrivalDay * 1440LL + (f->arrival >= 0 ? f->arrival : 0);
+                if (arrival >= neighbor->bestArrival) continue;
+                neighbor->bestArrival = arrival;
+                ArrivalLabel *l = neighbor->label;
+                if (!l || l->layer != k) {
+                    l = newLabel(all, neighbor, k);
+                    if (!l) {
+                        *noMemory = 1;
+                        return NULL;
+                    }
+                    neighbor->label = l;
+                    *tail = l;
+                    tail = &l->nextInLayer;
+                }
+                l->flight = af->fnode;
+                l->parent = cur;
+                l->date = legDate;
+                l->arrivalDay = arrivalDay;
+            }
         }
-        resetBFSFields(airportHead);
-        return 0;
+        layer = next;
     }
+    return goal->label;
+}
 
-    /* Reconstruct path */
-    Airport *cur = findAirport(airportHead, dest);
-    if (!cur) return 0;
-    int legs = 0;
-    Airport *it = cur;
-    while (it && it->parent) {
-        legs++;
-        it = it->parent;
-    }
-    if (legs == 0) {
-        printf("Source equals destination.\n");
-        resetBFSFields(airportHead);
-        return 1;
-    }
-    FlightNode **legsArr = (FlightNode**)malloc(sizeof(FlightNode*) * legs);
-    if (!legsArr) {
-        printf("Memory allocation failed for itinerary.\n");
-        resetBFSFields(airportHead);
-        return 0;
+ItineraryStatus planItinerary(Airport *airportHead, const char *src, const char *dest,
+                              int maxStops, int date, ItineraryLeg **legs, int *legCount) {
+    *legs = NULL;
+    *legCount = 0;
+    Airport *start = findAirport(airportHead, lookupSymbol(src));
+    Airport *goal = findAirport(airportHead, lookupSymbol(dest));
+    if (!start) return ITINERARY_NO_SOURCE;
+    if (!goal) return ITINERARY_NO_DESTINATION;
+    if (start == goal) return ITINERARY_SAME_AIRPORT;
+    resetBFSFields(airportHead);
+
+    ItineraryStatus status = ITINERARY_FOUND;
+    ArrivalLabel *all = NULL, *reached = NULL;
+    int found, noMemory = 0, count = 0;
+    if (date == DATE_NONE) {
+        found = searchUndated(airportHead, start, goal, maxStops);
+        for (Airport *it = goal; found && it->parent; it = it->parent) count++;
+    } else {
+        reached = searchDated(airportHead, start, goal, maxStops, date, &all, &noMemory);
+        found = reached != NULL;
+        count = found ? reached->layer : 0;
     }
-    int idx = legs - 1;
-    it = cur;
-    while (it && it->parent) {
-        legsArr[idx--] = it->parentFlight;
-        it = it->parent;
+    if (noMemory) {
+        status = ITINERARY_NO_MEMORY;
+    } else if (!found) {
+        status = ITINERARY_NOT_FOUND;
+    } else {
+        /* Reconstruct path */
+        ItineraryLeg *path = (ItineraryLeg*)malloc(sizeof(ItineraryLeg) * count);
+        if (!path) {
+            status = ITINERARY_NO_MEMORY;
+        } else {
+            int idx = count - 1;
+            if (reached) {
+                for (ArrivalLabel *l = reached; l->flight; l = l->parent, --idx) {
+                    path[idx].flight = &l->flight->flight;
+                    path[idx].date = l->date;
+                }
+            } else {
+                for (Airport *it = goal; it->parent; it = it->parent, --idx) {
+                    path[idx].flight = &it->parentFlight->flight;
+                    path[idx].date = DATE_NONE;
+                }
+            }
+            *legs = path;
+            *legCount = count;
+        }
     }
-    printf("Itinerary found from '%s' to '%s' with %d legs (stops allowed: %d):\n",
-           src, dest, legs, maxStops);
-    for (int i = 0; i < legs; ++i) {
-        Flight *f = &legsArr[i]->flight;
-        printf("Leg %d: Flight ID %d | %s -> %s | Airline: %s | Dep: %s Arr: %s\n",
-               i+1, f->id, f->source, f->destination, f->airline, f->departure, f->arrival);
+    while (all) {
+        ArrivalLabel *tmp = all;
+        all = all->nextAll;
+        free(tmp);
     }
-    free(legsArr);
     resetBFSFields(airportHead);
+    return status;
+}
+
+int findItinerary(Airport *airportHead, const char *src, const char *dest, int maxStops, int date) {
+    if (!airportHead || !src || !dest) return 0;
+    ItineraryLeg *legs;
+    int count;
+    switch (planItinerary(airportHead, src, dest, maxStops, date, &legs, &count)) {
+        case ITINERARY_NO_SOURCE:
+            printf("Source airport '%s' not found.\n", src);
+            return 0;
+        case ITINERARY_NO_DESTINATION:
+            printf("Destination airport '%s' not found.\n", dest);
+            return 0;
+        case ITINERARY_NOT_FOUND:
+            printf("No itinerary found from '%s' to '%s' within %d stops.\n", src, dest, maxStops);
+            return 0;
+        case ITINERARY_NO_MEMORY:
+            printf("Memory allocation failed for itinerary.\n");
+            return 0;
+        case ITINERARY_SAME_AIRPORT:
+            printf("Source equals destination.\n");
+            return 1;
+        case ITINERARY_FOUND:
+            break;
+    }
+    printf("Itinerary found from '%s' to '%s' with %d legs (stops allowed: %d):\n",
+           src, dest, count, maxStops);
+    char dep[6], arr[6], day[11];
+    for (int i = 0; i < count; ++i) {
+        const Flight *f = legs[i].flight;
+        printf("Leg %d: Flight ID %d | %s -> %s | Airline: %s | Dep: %s Arr: %s",
+               i+1, f->id, symbolName(f->source), symbolName(f->destination),
+               symbolName(f->airline), formatFlightTime(f, 0, dep), formatFlightTime(f, 1, arr));
+        if (legs[i].date != DATE_NONE) printf(" | Date: %s", formatDate(legs[i].date, day));
+        printf("\n");
+    }
+    free(legs);
     return 1;
-}
\ No newline at end of file
+}
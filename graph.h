@@ -11,7 +11,7 @@ typedef struct AdjFlight {
 
 /* Airport node (adjacency list head). Airports stored in a linked list. */
 typedef struct Airport {
-    char name[32];
+    SymbolID name;
     AdjFlight *adj;
     struct Airport *next;
 
@@ -19,14 +19,45 @@ typedef struct Airport {
     int visited;
     struct Airport *parent;
     FlightNode *parentFlight;
+    long long bestArrival;       /* dated search: earliest arrival so far (minutes after the travel date's midnight) */
+    struct ArrivalLabel *label;  /* dated search: this airport's entry in the current hop layer */
 } Airport;
 
 /* Build graph from flights linked list; frees existing graph if *head non-NULL */
 void buildGraph(Airport **head, FlightNode *flights);
 void freeGraph(Airport *head);
+/* Sort-based bulk build from an array of flight nodes. Returns 1 and stores the
+   graph in *out, or 0 on allocation failure (nothing leaked, *out untouched). */
+int buildGraphFromArray(Airport **out, FlightNode **nodes, size_t count);
+
+typedef enum {
+    ITINERARY_FOUND,
+    ITINERARY_SAME_AIRPORT,
+    ITINERARY_NO_SOURCE,
+    ITINERARY_NO_DESTINATION,
+    ITINERARY_NOT_FOUND,
+    ITINERARY_NO_MEMORY
+} ItineraryStatus;
+
+/* One leg of an itinerary: a borrowed flight and the date it is flown (DATE_NONE if undated) */
+typedef struct {
+    const Flight *flight;
+    int date;
+} ItineraryLeg;
+
+/* Shortest-hop itinerary without printing. On ITINERARY_FOUND, *legs is a malloc'd array
+   of *legCount legs in travel order (free the array, not the flights);
+   otherwise *legs is NULL. maxStops and date as for findItinerary. */
+ItineraryStatus planItinerary(Airport *airportHead, const char *src, const char *dest,
+                              int maxStops, int date, ItineraryLeg **legs, int *legCount);
 
 /* Find itinerary using BFS (shortest hops). Returns 1 if found and prints itinerary, 0 otherwise.
-   maxStops: number of intermediate stops allowed (0 = direct only). */
-int findItinerary(Airport *airportHead, const char *src, const char *dest, int maxStops);
+   maxStops: number of intermediate stops allowed (0 = direct only).
+   date: travel date (days since 1970-01-01) or DATE_NONE for any day. With a date, the
+   first leg must operate on that day; each later leg is taken on its first operating
+   day once the previous leg has landed (the next day at the earliest if it leaves
+   earlier on the clock than the previous leg lands). Among itineraries with the
+   fewest legs, the one arriving first is printed. */
+int findItinerary(Airport *airportHead, const char *src, const char *dest, int maxStops, int date);
 
 #endif
\ No newline at end of file
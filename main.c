@@ -8,18 +8,48 @@
 #include "fileio.h"
 #include "tree.h"
 #include "graph.h"
+#include "timeindex.h"
+#include "batch.h"
+#include "delay.h"
+#include "query.h"
+#include "allocator.h"
 
 #define DATAFILE "flights.txt"
+#define PAGE_SIZE 10
 
 void menu(void);
 
+/* Read a YYYY-MM-DD date; blank gives DATE_NONE (any day). Returns 0 if invalid. */
+static int readTravelDate(const char *prompt, int *date) {
+    printf("%s", prompt);
+    char *line = readLine(stdin);
+    if (!line) return 0;
+    int blank = line[strspn(line, " ")] == '\0';
+    *date = blank ? DATE_NONE : parseDate(line);
+    free(line);
+    if (!blank && *date == DATE_NONE) {
+        printf("Invalid date. Use YYYY-MM-DD.\n");
+        return 0;
+    }
+    return 1;
+}
+
 int main(void) {
     FlightNode *head = NULL;
     Stack emergencyStack;
     Queue boardingQueue;
     TreeNode *flightIndex = NULL;
     Airport *airportGraph = NULL;
+    TimeIndex timeIndex;
+    DelayEngine delays;
+    DelayRules rules = { DEFAULT_MIN_CONNECT, DEFAULT_MAX_CONNECT, DEFAULT_MAX_HOLD };
+    Allocation slots;
+    AllocRules allocRules = { DEFAULT_TURNAROUND, DEFAULT_BOARDING_LEAD, DEFAULT_RUNWAY_SLOT,
+                              DEFAULT_RUNWAYS, DEFAULT_GATES };
 
+    initTimeIndex(&timeIndex);
+    initDelayEngine(&delays, rules);
+    initAllocation(&slots, allocRules);
     initStack(&emergencyStack);
     initQueue(&boardingQueue);
 
@@ -30,6 +60,9 @@ int main(void) {
     loadFlights(&head, DATAFILE);
     flightIndex = buildTreeFromList(head);
     buildGraph(&airportGraph, head);
+    buildTimeIndex(&timeIndex, head);
+    buildDelayEngine(&delays, head, &timeIndex);
+    buildAllocation(&slots, &timeIndex, DATE_NONE);
 
     int choice;
     do {
@@ -53,12 +86,17 @@ int main(void) {
                 freeGraph(airportGraph);
                 airportGraph = NULL;
                 buildGraph(&airportGraph, head);
+                timeIndexAdd(&timeIndex, head);
+                buildDelayEngine(&delays, head, &timeIndex);
+                /* only the two airports the flight touches are re-planned */
+                reallocateAirport(&slots, &timeIndex, f.source);
+                reallocateAirport(&slots, &timeIndex, f.destination);
                 printf("Flight added successfully! ID: %d\n", f.id);
                 break;
             }
             case 2: {
                 int sc;
-                printf("Search by:\n1. Flight ID\n2. Destination\nChoice: ");
+                printf("Search by:\n1. Flight ID\n2. Destination\n3. Flight ID on a Date\nChoice: ");
                 if (scanf("%d", &sc) != 1) { while (getchar()!='\n'); break; }
                 getchar();
                 if (sc == 1) {
@@ -69,12 +107,28 @@ int main(void) {
                     FlightNode *found = searchFlightByID(head, id);
                     if (found) printFlight(&(found->flight));
                     else printf("Flight not found.\n");
+                } else if (sc == 3) {
+                    int id, date;
+                    printf("Enter Flight ID: ");
+                    if (scanf("%d", &id) != 1) { while (getchar()!='\n'); break; }
+                    getchar();
+                    if (!readTravelDate("Enter Date (YYYY-MM-DD): ", &date)) break;
+                    FlightNode *found = treeSearchInstance(flightIndex, id, date);
+                    if (found) {
+                        printFlight(&(found->flight));
+                    } else if ((found = treeSearchByID(flightIndex, id)) != NULL) {
+                        char day[11];
+                        int next = nextOperatingDate(&found->flight, date);
+                        printf("Flight %d does not operate on that date.", id);
+                        if (next != DATE_NONE) printf(" Next operating date: %s", formatDate(next, day));
+                        printf("\n");
+                    } else printf("Flight not found.\n");
                 } else {
-                    char dest[32];
                     printf("Enter Destination: ");
-                    fgets(dest, sizeof(dest), stdin);
-                    dest[strcspn(dest, "\n")] = 0;
+                    char *dest = readLine(stdin);
+                    if (!dest) break;
                     searchFlightByDestination(head, dest);
+                    free(dest);
                 }
                 break;
             }
@@ -83,12 +137,22 @@ int main(void) {
                 printf("Enter Flight ID to delete: ");
                 if (scanf("%d", &id) != 1) { while (getchar()!='\n'); break; }
                 getchar();
+                FlightNode *victim = searchFlightByID(head, id);
+                SymbolID from = SYMBOL_NONE, to = SYMBOL_NONE;
+                if (victim) {
+                    from = victim->flight.source;
+                    to = victim->flight.destination;
+                    timeIndexRemove(&timeIndex, victim);
+                }
                 if (deleteFlight(&head, id)) {
                     freeTree(flightIndex);
                     flightIndex = buildTreeFromList(head);
                     freeGraph(airportGraph);
                     airportGraph = NULL;
                     buildGraph(&airportGraph, head);
+                    buildDelayEngine(&delays, head, &timeIndex);
+                    reallocateAirport(&slots, &timeIndex, from);
+                    reallocateAirport(&slots, &timeIndex, to);
                     printf("Flight deleted.\n");
                 } else printf("Flight not found.\n");
                 break;
@@ -151,19 +215,237 @@ int main(void) {
                 printf("Data saved to %s\n", DATAFILE);
                 break;
             case 14: {
-                char src[32], dest[32];
                 int maxStops;
                 printf("Enter Source Airport: ");
-                fgets(src, sizeof(src), stdin);
-                src[strcspn(src, "\n")] = 0;
+                char *src = readLine(stdin);
                 printf("Enter Destination Airport: ");
-                fgets(dest, sizeof(dest), stdin);
-                dest[strcspn(dest, "\n")] = 0;
+                char *dest = readLine(stdin);
                 printf("Enter maximum allowed stops (0 = direct only): ");
-                if (scanf("%d", &maxStops) != 1) { while (getchar()!='\n'); break; }
+                if (!src || !dest || scanf("%d", &maxStops) != 1) {
+                    while (getchar()!='\n');
+                    free(src);
+                    free(dest);
+                    break;
+                }
+                getchar();
+                int date;
+                if (readTravelDate("Enter travel date (YYYY-MM-DD, blank = any day): ", &date)) {
+                    if (!airportGraph) buildGraph(&airportGraph, head);
+                    findItinerary(airportGraph, src, dest, maxStops, date);
+                }
+                free(src);
+                free(dest);
+                break;
+            }
+            case 15: {
+                char from[16], to[16];
+                int dir;
+                printf("Enter Airport: ");
+                char *airport = readLine(stdin);
+                if (!airport) break;
+                printf("Show:\n1. Departures\n2. Arrivals\nChoice: ");
+                if (scanf("%d", &dir) != 1) { while (getchar()!='\n'); free(airport); break; }
+                getchar();
+                printf("Enter window start (HH:MM): ");
+                fgets(from, sizeof(from), stdin);
+                from[strcspn(from, "\n")] = 0;
+                printf("Enter window end (HH:MM): ");
+                fgets(to, sizeof(to), stdin);
+                to[strcspn(to, "\n")] = 0;
+                int fromMin = parseTimeMinutes(from);
+                int toMin = parseTimeMinutes(to);
+                if (fromMin < 0 || toMin < 0) printf("Invalid time. Use HH:MM.\n");
+                else printFlightsInWindow(&timeIndex, airport,
+                                          dir == 2 ? TIME_ARRIVALS : TIME_DEPARTURES, fromMin, toMin);
+                free(airport);
+                break;
+            }
+            case 16: {
+                printf("Enter CSV file to import: ");
+                char *filename = readLine(stdin);
+                if (!filename) break;
+                FlightBatch batch;
+                initBatch(&batch);
+                int staged = loadFlightBatch(&batch, filename);
+                if (staged < 0) printf("Could not open %s\n", filename);
+                else if (commitBatch(&batch, &head, &flightIndex, &airportGraph, &timeIndex)) {
+                    buildDelayEngine(&delays, head, &timeIndex);
+                    buildAllocation(&slots, &timeIndex, slots.date);
+                    printf("Imported %d flights from %s\n", staged, filename);
+                }
+                freeBatch(&batch);
+                free(filename);
+                break;
+            }
+            case 17: {
+                printf("Enter Airline to cancel: ");
+                char *airline = readLine(stdin);
+                if (!airline) break;
+                SymbolID target = lookupSymbol(airline);
+                FlightBatch batch;
+                initBatch(&batch);
+                for (FlightNode *cur = head; cur && target != SYMBOL_NONE; cur = cur->next) {
+                    if (cur->flight.airline == target) batchDeleteFlight(&batch, cur->flight.id);
+                }
+                size_t cancelled = batch.deleteCount;
+                if (!cancelled) printf("No flights found for airline: %s\n", airline);
+                else if (commitBatch(&batch, &head, &flightIndex, &airportGraph, &timeIndex)) {
+                    buildDelayEngine(&delays, head, &timeIndex);
+                    buildAllocation(&slots, &timeIndex, slots.date);
+                    printf("Cancelled %zu flights of %s\n", cancelled, airline);
+                }
+                freeBatch(&batch);
+                free(airline);
+                break;
+            }
+            case 18: {
+                int id, minutes;
+                printf("Enter Flight ID: ");
+                if (scanf("%d", &id) != 1) { while (getchar()!='\n'); break; }
+                printf("Enter delay in minutes (0 = on time): ");
+                if (scanf("%d", &minutes) != 1) { while (getchar()!='\n'); break; }
+                getchar();
+                if (reportDelay(&delays, id, minutes)) printDelayImpact(&delays);
+                else printf("No flight with ID %d.\n", id);
+                break;
+            }
+            case 19: {
+                int date;
+                if (!readTravelDate("Enter Date (YYYY-MM-DD): ", &date)) break;
+                if (date == DATE_NONE) {
+                    printf("A date is required.\n");
+                    break;
+                }
+                if (!printFlightsOnDate(flightIndex, date)) printf("No flights operate on that date.\n");
+                break;
+            }
+            case 20: {
+                int format;
+                printf("Export format:\n1. CSV\n2. JSON\nChoice: ");
+                if (scanf("%d", &format) != 1) { while (getchar()!='\n'); break; }
                 getchar();
-                if (!airportGraph) buildGraph(&airportGraph, head);
-                findItinerary(airportGraph, src, dest, maxStops);
+                printf("Enter output file: ");
+                char *filename = readLine(stdin);
+                if (!filename) break;
+                FILE *fp = fopen(filename, "w");
+                FlightCursor c;
+                if (!fp) {
+                    printf("Could not open %s\n", filename);
+                } else if (!cursorAllByID(&c, flightIndex)) {
+                    printf("Memory allocation failed for index traversal.\n");
+                    fclose(fp);
+                } else {
+                    size_t n = writeFlights(fp, &c, format == 2 ? FORMAT_JSON : FORMAT_CSV);
+                    closeCursor(&c);
+                    fclose(fp);
+                    printf("Exported %zu flights to %s\n", n, filename);
+                }
+                free(filename);
+                break;
+            }
+            case 21: {
+                /* one cursor for the whole walk: each page resumes where the last stopped */
+                FlightCursor c;
+                const Flight *page[PAGE_SIZE];
+                if (!cursorAllByID(&c, flightIndex)) {
+                    printf("Memory allocation failed for index traversal.\n");
+                    break;
+                }
+                size_t shown = 0, n;
+                while ((n = cursorPage(&c, page, PAGE_SIZE)) > 0) {
+                    FlightCursor pageCursor;
+                    cursorOverArray(&pageCursor, page, n);
+                    writeFlights(stdout, &pageCursor, FORMAT_TEXT);
+                    shown += n;
+                    if (n < PAGE_SIZE) break;
+                    printf("-- %zu shown; Enter = next page, q = stop: ", shown);
+                    char *answer = readLine(stdin);
+                    int stop = !answer || answer[0] == 'q' || answer[0] == 'Q';
+                    free(answer);
+                    if (stop) break;
+                }
+                if (!shown) printf("No flights available.\n");
+                closeCursor(&c);
+                break;
+            }
+            case 22: {
+                printf("Enter Airport: ");
+                char *airport = readLine(stdin);
+                if (!airport) break;
+                int date;
+                if (readTravelDate("Enter Date (YYYY-MM-DD, blank = every flight): ", &date)) {
+                    if (date != slots.date && !buildAllocation(&slots, &timeIndex, date)) {
+                        printf("Memory allocation failed while planning gates.\n");
+                    }
+                    printAllocation(&slots, airport);
+                }
+                free(airport);
+                break;
+            }
+            case 23: {
+                int id;
+                printf("Enter Flight ID to retime: ");
+                if (scanf("%d", &id) != 1) { while (getchar()!='\n'); break; }
+                getchar();
+                FlightNode *target = searchFlightByID(head, id);
+                if (!target) {
+                    printf("Flight not found.\n");
+                    break;
+                }
+                printf("Enter new Departure Time (HH:MM): ");
+                char *dep = readLine(stdin);
+                printf("Enter new Arrival Time (HH:MM): ");
+                char *arr = readLine(stdin);
+                int depMin = dep ? parseTimeMinutes(dep) : -1;
+                int arrMin = arr ? parseTimeMinutes(arr) : -1;
+                free(dep);
+                free(arr);
+                if (depMin < 0 || arrMin < 0) {
+                    printf("Invalid time. Use HH:MM.\n");
+                    break;
+                }
+                timeIndexRemove(&timeIndex, target);
+                target->flight.departure = (int16_t)depMin;
+                target->flight.arrival = (int16_t)arrMin;
+                target->flight.departureText = SYMBOL_NONE;
+                target->flight.arrivalText = SYMBOL_NONE;
+                timeIndexAdd(&timeIndex, target);
+                buildDelayEngine(&delays, head, &timeIndex);
+                reallocateAirport(&slots, &timeIndex, target->flight.source);
+                reallocateAirport(&slots, &timeIndex, target->flight.destination);
+                printf("Flight %d retimed.\n", id);
+                break;
+            }
+            case 24: {
+                int gates;
+                printf("Enter Airport (blank = every airport): ");
+                char *airport = readLine(stdin);
+                printf("Enter Airline: ");
+                char *airline = readLine(stdin);
+                printf("Gates reserved for the airline (0 = remove): ");
+                if (!airport || !airline || scanf("%d", &gates) != 1) {
+                    while (getchar()!='\n');
+                    free(airport);
+                    free(airline);
+                    break;
+                }
+                getchar();
+                printf("Exclusive (airline may not use common gates)? (y/n): ");
+                char *answer = readLine(stdin);
+                int exclusive = answer && (answer[0] == 'y' || answer[0] == 'Y');
+                free(answer);
+                int everywhere = airport[strspn(airport, " ")] == '\0';
+                SymbolID where = everywhere ? SYMBOL_NONE : internSymbol(airport);
+                if (!setGateRule(&slots, where, internSymbol(airline), gates, exclusive)) {
+                    printf("Memory allocation failed for gate rule.\n");
+                } else if (everywhere ? !buildAllocation(&slots, &timeIndex, slots.date)
+                                      : !reallocateAirport(&slots, &timeIndex, where)) {
+                    printf("Memory allocation failed while planning gates.\n");
+                } else {
+                    printf("Gate rule updated.\n");
+                }
+                free(airport);
+                free(airline);
                 break;
             }
             case 0:
@@ -172,6 +454,10 @@ int main(void) {
                 freeTree(flightIndex);
                 freeQueue(&boardingQueue);
                 freeGraph(airportGraph);
+                freeTimeIndex(&timeIndex);
+                freeDelayEngine(&delays);
+                freeAllocation(&slots);
+                freeSymbols();
                 printf("Exiting. Data saved.\n");
                 break;
             default:
@@ -198,5 +484,15 @@ void menu(void) {
     printf("12. Rebuild Flight Index (tree)\n");
     printf("13. Save Data Now\n");
     printf("14. Find Itinerary / Connections (BFS on airport graph)\n");
+    printf("15. Departures / Arrivals in Time Window (per airport)\n");
+    printf("16. Import Flights from CSV (batch)\n");
+    printf("17. Cancel All Flights of an Airline (batch)\n");
+    printf("18. Report Flight Delay (propagate to connections)\n");
+    printf("19. Flights Operating on a Date (recurring schedules)\n");
+    printf("20. Export Flights Sorted by ID (CSV / JSON)\n");
+    printf("21. Browse Flights Page by Page\n");
+    printf("22. Gate & Runway Plan for an Airport\n");
+    printf("23. Retime Flight\n");
+    printf("24. Reserve Gates for an Airline\n");
     printf("0. Exit\n");
 }
\ No newline at end of file
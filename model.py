@@ -3,12 +3,27 @@
 
 from dataclasses import dataclass, field
 from typing import List, Optional, Dict, Tuple
+import bisect
 import csv
 import os
 
 DATAFILE = "flights.txt"
 
 
+def parse_time_minutes(text: str) -> Optional[int]:
+    """Parse 'HH:MM' / 'HHMM' into minutes since midnight (None if invalid). Mirrors parseTimeMinutes in C."""
+    text = text.strip()
+    digits = text.replace(':', '')
+    if not digits.isdigit() or not 3 <= len(digits) <= 4:
+        return None
+    if ':' in text and (text.count(':') > 1 or text.index(':') != len(text) - 3):
+        return None
+    hours, mins = int(digits[:-2]), int(digits[-2:])
+    if hours > 23 or mins > 59:
+        return None
+    return hours * 60 + mins
+
+
 @dataclass
 class Flight:
     id: int
@@ -17,6 +32,10 @@ class Flight:
     destination: str
     departure: str
     arrival: str
+    # recurring schedule (optional CSV columns 7-9, written by the C program); '' = daily / open-ended
+    days: str = ''
+    valid_from: str = ''
+    valid_to: str = ''
 
 
 class Stack:
@@ -76,6 +95,9 @@ class FlightManager:
         self.boarding_queue = Queue()
         self.tree_root: Optional[TreeNode] = None
         self.graph_adj: Dict[str, List[Flight]] = {}  # source -> list of outgoing flights
+        # airport -> sorted [(minutes, id, flight)] for departures / arrivals
+        self.departures_by_time: Dict[str, List[Tuple[int, int, Flight]]] = {}
+        self.arrivals_by_time: Dict[str, List[Tuple[int, int, Flight]]] = {}
         self._load()
         self._rebuild_indices()
 
@@ -103,6 +125,8 @@ class FlightManager:
                     departure=row[4],
                     arrival=row[5]
                 )
+                if len(row) >= 9:
+                    flight.days, flight.valid_from, flight.valid_to = row[6], row[7], row[8]
                 # append to keep chronological order
                 self.flights.append(flight)
 
@@ -110,7 +134,10 @@ class FlightManager:
         with open(self.datafile, 'w', newline='', encoding='utf-8') as f:
             writer = csv.writer(f)
             for fl in self.flights:
-                writer.writerow([fl.id, fl.airline, fl.source, fl.destination, fl.departure, fl.arrival])
+                row = [fl.id, fl.airline, fl.source, fl.destination, fl.departure, fl.arrival]
+                if fl.days:
+                    row += [fl.days, fl.valid_from or '-', fl.valid_to or '-']
+                writer.writerow(row)
 
     # ---------------------
     # ID generation
@@ -133,6 +160,7 @@ class FlightManager:
         # update indices
         self._insert_into_tree(flight)
         self._add_to_graph(flight)
+        self._add_to_time_index(flight)
         self.save()
         return flight
 
@@ -297,12 +325,47 @@ class FlightManager:
         legs.reverse()
         return legs
 
+    # ---------------------
+    # Per-airport time index (departures / arrivals by minutes since midnight)
+    # ---------------------
+    def _add_to_time_index(self, flight: Flight):
+        dep = parse_time_minutes(flight.departure)
+        if dep is not None:
+            bisect.insort(self.departures_by_time.setdefault(flight.source, []), (dep, flight.id, flight))
+        arr = parse_time_minutes(flight.arrival)
+        if arr is not None:
+            bisect.insort(self.arrivals_by_time.setdefault(flight.destination, []), (arr, flight.id, flight))
+
+    def _build_time_index(self):
+        self.departures_by_time = {}
+        self.arrivals_by_time = {}
+        for f in self.flights:
+            self._add_to_time_index(f)
+
+    def flights_in_window(self, airport: str, start: str, end: str, arrivals: bool = False) -> List[Flight]:
+        """
+        Departures from (or arrivals into) airport between start and end (HH:MM, inclusive).
+        A window with start > end wraps past midnight.
+        """
+        lo, hi = parse_time_minutes(start), parse_time_minutes(end)
+        if lo is None or hi is None:
+            return []
+        entries = (self.arrivals_by_time if arrivals else self.departures_by_time).get(airport, [])
+        ranges = [(lo, hi)] if lo <= hi else [(lo, 1439), (0, hi)]
+        result: List[Flight] = []
+        for a, b in ranges:
+            first = bisect.bisect_left(entries, (a,))
+            last = bisect.bisect_left(entries, (b + 1,))
+            result.extend(e[2] for e in entries[first:last])
+        return result
+
     # ---------------------
     # Utilities
     # ---------------------
     def _rebuild_indices(self):
         self._build_tree()
         self._build_graph()
+        self._build_time_index()
 
     def rebuild(self):
         """Public rebuild (call after external edits or many changes)."""
@@ -0,0 +1,163 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <string.h>
+#include "psort.h"
+
+#ifndef FLIGHT_NO_THREADS
+#include <pthread.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+#endif
+
+#define MAX_WORKERS 64
+/* Below this many elements per chunk a thread costs more than it saves */
+#define MIN_CHUNK 16384
+
+int parallelWorkers(void) {
+#ifdef FLIGHT_NO_THREADS
+    return 1;
+#else
+    static int workers = 0;
+    if (workers == 0) {
+        long n;
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        n = (long)info.dwNumberOfProcessors;
+#else
+        n = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+        if (n < 1) n = 1;
+        if (n > MAX_WORKERS) n = MAX_WORKERS;
+        workers = (int)n;
+    }
+    return workers;
+#endif
+}
+
+typedef struct {
+    int first;  /* this worker runs tasks first, first+stride, ... */
+    int stride;
+    int tasks;
+    void (*fn)(int task, void *ctx);
+    void *ctx;
+} RunShare;
+
+static void* runShare(void *arg) {
+    RunShare *share = (RunShare*)arg;
+    for (int t = share->first; t < share->tasks; t += share->stride) {
+        share->fn(t, share->ctx);
+    }
+    return NULL;
+}
+
+void parallelRun(int tasks, void (*fn)(int task, void *ctx), void *ctx) {
+    if (tasks <= 0) return;
+    int workers = parallelWorkers();
+    if (workers > tasks) workers = tasks;
+    RunShare shares[MAX_WORKERS];
+    for (int w = 0; w < workers; ++w) {
+        shares[w].first = w;
+        shares[w].stride = workers;
+        shares[w].tasks = tasks;
+        shares[w].fn = fn;
+        shares[w].ctx = ctx;
+    }
+#ifdef FLIGHT_NO_THREADS
+    runShare(&shares[0]);
+#else
+    pthread_t threads[MAX_WORKERS];
+    int started[MAX_WORKERS] = {0};
+    /* worker 0 runs on the calling thread; a share whose thread cannot start runs inline */
+    for (int w = 1; w < workers; ++w) {
+        started[w] = pthread_create(&threads[w], NULL, runShare, &shares[w]) == 0;
+    }
+    runShare(&shares[0]);
+    for (int w = 1; w < workers; ++w) {
+        if (started[w]) pthread_join(threads[w], NULL);
+        else runShare(&shares[w]);
+    }
+#endif
+}
+
+typedef struct {
+    char *src;        /* current runs */
+    char *dst;        /* merge target */
+    size_t size;
+    size_t *bounds;   /* run i is [bounds[i], bounds[i+1]) */
+    int runs;
+    int (*compare)(const void *, const void *);
+} SortState;
+
+static void sortChunk(int task, void *ctx) {
+    SortState *s = (SortState*)ctx;
+    size_t lo = s->bounds[task], hi = s->bounds[task + 1];
+    qsort(s->src + lo * s->size, hi - lo, s->size, s->compare);
+}
+
+/* Merge runs 2*task and 2*task+1 from src into dst (a lone last run is copied) */
+static void mergePair(int task, void *ctx) {
+    SortState *s = (SortState*)ctx;
+    int left = task * 2;
+    size_t size = s->size;
+    size_t a = s->bounds[left];
+    size_t aEnd = s->bounds[left + 1];
+    size_t b = aEnd;
+    size_t bEnd = (left + 1 < s->runs) ? s->bounds[left + 2] : aEnd;
+    char *out = s->dst + a * size;
+    while (a < aEnd && b < bEnd) {
+        /* take from the right run only when strictly smaller */
+        if (s->compare(s->src + b * size, s->src + a * size) < 0) {
+            memcpy(out, s->src + b * size, size);
+            b++;
+        } else {
+            memcpy(out, s->src + a * size, size);
+            a++;
+        }
+        out += size;
+    }
+    memcpy(out, s->src + a * size, (aEnd - a) * size);
+    out += (aEnd - a) * size;
+    memcpy(out, s->src + b * size, (bEnd - b) * size);
+}
+
+void parallelSort(void *base, size_t count, size_t size,
+                  int (*compare)(const void *, const void *)) {
+    if (count < 2) return;
+    size_t chunks = (size_t)parallelWorkers();
+    if (chunks > count / MIN_CHUNK) chunks = count / MIN_CHUNK;
+    char *scratch = NULL;
+    size_t bounds[MAX_WORKERS + 1];
+    if (chunks >= 2) scratch = (char*)malloc(count * size);
+    if (!scratch) {
+        qsort(base, count, size, compare);
+        return;
+    }
+
+    SortState s;
+    s.src = (char*)base;
+    s.dst = scratch;
+    s.size = size;
+    s.bounds = bounds;
+    s.runs = (int)chunks;
+    s.compare = compare;
+    for (size_t i = 0; i <= chunks; ++i) bounds[i] = count * i / chunks;
+    parallelRun(s.runs, sortChunk, &s);
+
+    /* merge rounds: runs halve each round, buffers swap roles */
+    while (s.runs > 1) {
+        int pairs = (s.runs + 1) / 2;
+        parallelRun(pairs, mergePair, &s);
+        for (int i = 0; i < pairs; ++i) bounds[i] = bounds[i * 2];
+        bounds[pairs] = count;
+        s.runs = pairs;
+        char *tmp = s.src;
+        s.src = s.dst;
+        s.dst = tmp;
+    }
+    if (s.src != (char*)base) memcpy(base, s.src, count * size);
+    free(scratch);
+}
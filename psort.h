@@ -0,0 +1,21 @@
+#ifndef PSORT_H
+#define PSORT_H
+
+#include <stddef.h>
+
+/* Number of worker threads used by the parallel helpers (>= 1).
+   Build with -DFLIGHT_NO_THREADS to force single-threaded operation. */
+int parallelWorkers(void);
+
+/* Run fn(task, ctx) for every task in [0, tasks) spread across worker threads.
+   Returns once all tasks have finished. */
+void parallelRun(int tasks, void (*fn)(int task, void *ctx), void *ctx);
+
+/* Sort like qsort, splitting the array into per-thread chunks that are sorted
+   concurrently and then merged pairwise. The comparator must be a total order
+   (no two distinct elements compare equal) for the result to be deterministic.
+   Falls back to plain qsort for small inputs or if scratch memory is unavailable. */
+void parallelSort(void *base, size_t count, size_t size,
+                  int (*compare)(const void *, const void *));
+
+#endif
@@ -0,0 +1,331 @@
+#include <stdlib.h>
+#include <string.h>
+#include "query.h"
+
+/* ---- cursors ---- */
+
+void cursorAllFlights(FlightCursor *c, FlightNode *head) {
+    memset(c, 0, sizeof(*c));
+    c->kind = CURSOR_LIST;
+    c->date = DATE_NONE;
+    c->node = head;
+    c->destination = SYMBOL_NONE;
+}
+
+void cursorByDestination(FlightCursor *c, FlightNode *head, const char *destination) {
+    cursorAllFlights(c, head);
+    c->filtered = 1;
+    /* a name that was never interned cannot match any flight */
+    c->destination = lookupSymbol(destination);
+    if (c->destination == SYMBOL_NONE) c->node = NULL;
+}
+
+static int pushTree(FlightCursor *c, TreeNode *node) {
+    if (c->depth == c->capacity) {
+        size_t cap = c->capacity ? c->capacity * 2 : 32;
+        TreeNode **stack = (TreeNode**)realloc(c->stack, cap * sizeof(TreeNode*));
+        if (!stack) return 0;
+        c->stack = stack;
+        c->capacity = cap;
+    }
+    c->stack[c->depth++] = node;
+    return 1;
+}
+
+/* Push node and its left spine: the next result is then on top */
+static int pushLeftSpine(FlightCursor *c, TreeNode *node) {
+    for (; node; node = node->left) {
+        if (!pushTree(c, node)) return 0;
+    }
+    return 1;
+}
+
+static void initTreeCursor(FlightCursor *c) {
+    memset(c, 0, sizeof(*c));
+    c->kind = CURSOR_TREE;
+    c->date = DATE_NONE;
+    c->destination = SYMBOL_NONE;
+}
+
+int cursorAllByID(FlightCursor *c, TreeNode *root) {
+    initTreeCursor(c);
+    if (!pushLeftSpine(c, root)) {
+        closeCursor(c);
+        return 0;
+    }
+    return 1;
+}
+
+int cursorSortedByID(FlightCursor *c, TreeNode *root, int afterID) {
+    initTreeCursor(c);
+    /* seek: keep only ancestors whose ID is past afterID, so resuming costs
+       one root-to-leaf walk instead of skipping the earlier pages */
+    for (TreeNode *node = root; node; ) {
+        if (node->fnode->flight.id > afterID) {
+            if (!pushTree(c, node)) {
+                closeCursor(c);
+                return 0;
+            }
+            node = node->left;
+        } else {
+            node = node->right;
+        }
+    }
+    return 1;
+}
+
+void cursorOverArray(FlightCursor *c, const Flight **items, size_t count) {
+    memset(c, 0, sizeof(*c));
+    c->kind = CURSOR_ARRAY;
+    c->date = DATE_NONE;
+    c->destination = SYMBOL_NONE;
+    c->items = items;
+    c->count = count;
+}
+
+void cursorFilterDate(FlightCursor *c, int date) {
+    c->date = date;
+}
+
+static const Flight* nextUnfiltered(FlightCursor *c) {
+    switch (c->kind) {
+        case CURSOR_LIST:
+            while (c->node) {
+                FlightNode *cur = c->node;
+                c->node = cur->next;
+                if (!c->filtered || cur->flight.destination == c->destination) return &cur->flight;
+            }
+            return NULL;
+        case CURSOR_TREE: {
+            if (!c->depth) return NULL;
+            TreeNode *node = c->stack[--c->depth];
+            /* the right subtree's left spine needs at most its height in new slots;
+               if that cannot be allocated the cursor ends early */
+            if (!pushLeftSpine(c, node->right)) c->depth = 0;
+            return &node->fnode->flight;
+        }
+        case CURSOR_ARRAY:
+            if (c->pos >= c->count) return NULL;
+            return c->items[c->pos++];
+    }
+    return NULL;
+}
+
+const Flight* cursorNext(FlightCursor *c) {
+    const Flight *f = nextUnfiltered(c);
+    while (f && !flightOperatesOn(f, c->date)) f = nextUnfiltered(c);
+    return f;
+}
+
+size_t cursorPage(FlightCursor *c, const Flight **out, size_t max) {
+    size_t n = 0;
+    while (n < max) {
+        const Flight *f = cursorNext(c);
+        if (!f) break;
+        out[n++] = f;
+    }
+    return n;
+}
+
+void closeCursor(FlightCursor *c) {
+    free(c->stack);
+    c->stack = NULL;
+    c->depth = 0;
+    c->capacity = 0;
+    c->node = NULL;
+    c->pos = c->count;
+}
+
+/* ---- buffered output ---- */
+
+#define OUT_BUFFER_SIZE 65536
+
+typedef struct {
+    FILE *fp;
+    char *data;
+    size_t capacity;
+    size_t len;
+} OutBuffer;
+
+static void flushOut(OutBuffer *out) {
+    if (out->len) fwrite(out->data, 1, out->len, out->fp);
+    out->len = 0;
+}
+
+static void appendBytes(OutBuffer *out, const char *bytes, size_t len) {
+    if (out->len + len > out->capacity) {
+        flushOut(out);
+        /* a field larger than the whole buffer goes straight through */
+        if (len > out->capacity) {
+            fwrite(bytes, 1, len, out->fp);
+            return;
+        }
+    }
+    memcpy(out->data + out->len, bytes, len);
+    out->len += len;
+}
+
+static void appendText(OutBuffer *out, const char *text) {
+    appendBytes(out, text, strlen(text));
+}
+
+static void appendInt(OutBuffer *out, int value) {
+    char buf[12];
+    char *p = buf + sizeof(buf);
+    unsigned u = value < 0 ? 0u - (unsigned)value : (unsigned)value;
+    do {
+        *--p = (char)('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (value < 0) *--p = '-';
+    appendBytes(out, p, (size_t)(buf + sizeof(buf) - p));
+}
+
+/* Quote only when the field needs it (RFC 4180) */
+static void appendCSVField(OutBuffer *out, const char *text) {
+    if (!strpbrk(text, ",\"\r\n")) {
+        appendText(out, text);
+        return;
+    }
+    appendBytes(out, "\"", 1);
+    for (const char *p = text; *p; ++p) {
+        if (*p == '"') appendBytes(out, "\"\"", 2);
+        else appendBytes(out, p, 1);
+    }
+    appendBytes(out, "\"", 1);
+}
+
+static void appendJSONString(OutBuffer *out, const char *text) {
+    appendBytes(out, "\"", 1);
+    for (const unsigned char *p = (const unsigned char*)text; *p; ++p) {
+        if (*p == '"' || *p == '\\') {
+            char esc[2] = {'\\', (char)*p};
+            appendBytes(out, esc, 2);
+        } else if (*p < 0x20) {
+            char esc[8];
+            snprintf(esc, sizeof(esc), "\\u%04x", *p);
+            appendBytes(out, esc, 6);
+        } else {
+            appendBytes(out, (const char*)p, 1);
+        }
+    }
+    appendBytes(out, "\"", 1);
+}
+
+static void appendJSONDate(OutBuffer *out, int date) {
+    char buf[11];
+    if (date == DATE_NONE) appendText(out, "null");
+    else appendJSONString(out, formatDate(date, buf));
+}
+
+static void appendFlight(OutBuffer *out, const Flight *f, OutputFormat format) {
+    char depBuf[6], arrBuf[6], days[8], from[11], to[11];
+    const char *dep = formatFlightTime(f, 0, depBuf);
+    const char *arr = formatFlightTime(f, 1, arrBuf);
+    switch (format) {
+        case FORMAT_TEXT:
+            appendText(out, "ID: ");
+            appendInt(out, f->id);
+            appendText(out, " | Airline: ");
+            appendText(out, symbolName(f->airline));
+            appendText(out, " | ");
+            appendText(out, symbolName(f->source));
+            appendText(out, " -> ");
+            appendText(out, symbolName(f->destination));
+            appendText(out, " | Dep: ");
+            appendText(out, dep);
+            appendText(out, " | Arr: ");
+            appendText(out, arr);
+            if (!isDailySchedule(f)) {
+                appendText(out, " | Days: ");
+                appendText(out, formatDays(f->days, days));
+                appendText(out, " | Valid: ");
+                appendText(out, formatDate(f->validFrom, from));
+                appendText(out, " .. ");
+                appendText(out, formatDate(f->validTo, to));
+            }
+            appendBytes(out, "\n", 1);
+            break;
+        case FORMAT_CSV:
+            appendInt(out, f->id);
+            appendBytes(out, ",", 1);
+            appendCSVField(out, symbolName(f->airline));
+            appendBytes(out, ",", 1);
+            appendCSVField(out, symbolName(f->source));
+            appendBytes(out, ",", 1);
+            appendCSVField(out, symbolName(f->destination));
+            appendBytes(out, ",", 1);
+            appendCSVField(out, dep);
+            appendBytes(out, ",", 1);
+            appendCSVField(out, arr);
+            /* daily flights keep the original six-column format */
+            if (!isDailySchedule(f)) {
+                appendBytes(out, ",", 1);
+                appendText(out, formatDays(f->days, days));
+                appendBytes(out, ",", 1);
+                appendText(out, formatDate(f->validFrom, from));
+                appendBytes(out, ",", 1);
+                appendText(out, formatDate(f->validTo, to));
+            }
+            appendBytes(out, "\n", 1);
+            break;
+        case FORMAT_JSON:
+            appendText(out, "{\"id\":");
+            appendInt(out, f->id);
+            appendText(out, ",\"airline\":");
+            appendJSONString(out, symbolName(f->airline));
+            appendText(out, ",\"source\":");
+            appendJSONString(out, symbolName(f->source));
+            appendText(out, ",\"destination\":");
+            appendJSONString(out, symbolName(f->destination));
+            appendText(out, ",\"departure\":");
+            appendJSONString(out, dep);
+            appendText(out, ",\"arrival\":");
+            appendJSONString(out, arr);
+            appendText(out, ",\"days\":");
+            appendJSONString(out, formatDays(f->days, days));
+            appendText(out, ",\"validFrom\":");
+            appendJSONDate(out, f->validFrom);
+            appendText(out, ",\"validTo\":");
+            appendJSONDate(out, f->validTo);
+            appendBytes(out, "}", 1);
+            break;
+    }
+}
+
+size_t writeFlights(FILE *fp, FlightCursor *c, OutputFormat format) {
+    char fallback[512];
+    OutBuffer out;
+    out.fp = fp;
+    out.len = 0;
+    out.data = (char*)malloc(OUT_BUFFER_SIZE);
+    out.capacity = OUT_BUFFER_SIZE;
+    if (!out.data) {
+        /* still correct without the big buffer, just more writes */
+        out.data = fallback;
+        out.capacity = sizeof(fallback);
+    }
+    size_t count = 0;
+    const Flight *f;
+    if (format == FORMAT_JSON) appendBytes(&out, "[", 1);
+    while ((f = cursorNext(c))) {
+        if (format == FORMAT_JSON) appendText(&out, count ? ",\n" : "\n");
+        appendFlight(&out, f, format);
+        count++;
+    }
+    if (format == FORMAT_JSON) appendText(&out, count ? "\n]\n" : "]\n");
+    flushOut(&out);
+    if (out.data != fallback) free(out.data);
+    return count;
+}
+
+void writeFlight(FILE *fp, const Flight *flight, OutputFormat format) {
+    char data[512];
+    OutBuffer out;
+    out.fp = fp;
+    out.data = data;
+    out.capacity = sizeof(data);
+    out.len = 0;
+    appendFlight(&out, flight, format);
+    flushOut(&out);
+}
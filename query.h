@@ -0,0 +1,65 @@
+#ifndef QUERY_H
+#define QUERY_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include "flight.h"
+#include "tree.h"
+
+/* Cursor over query results. Results are borrowed pointers into the flight
+   list (no copies); a cursor stays valid until the list is modified.
+   Cursors are resumable: each cursorNext / cursorPage continues where the
+   previous call stopped. */
+typedef enum {
+    CURSOR_LIST,   /* linked-list order, optionally filtered by destination */
+    CURSOR_TREE,   /* ascending flight ID (BST inorder) */
+    CURSOR_ARRAY   /* caller-supplied array, e.g. itinerary legs */
+} CursorKind;
+
+typedef struct {
+    CursorKind kind;
+    /* CURSOR_LIST */
+    FlightNode *node;
+    SymbolID destination;  /* SYMBOL_NONE = no filter */
+    int filtered;
+    int date;              /* DATE_NONE = no filter; else only flights operating that day */
+    /* CURSOR_TREE: explicit stack of pending ancestors */
+    TreeNode **stack;
+    size_t depth;
+    size_t capacity;
+    /* CURSOR_ARRAY */
+    const Flight **items;
+    size_t count;
+    size_t pos;
+} FlightCursor;
+
+void cursorAllFlights(FlightCursor *c, FlightNode *head);
+void cursorByDestination(FlightCursor *c, FlightNode *head, const char *destination);
+/* Every flight in ascending ID order (any ID, including 0 and negative ones).
+   Returns 0 on allocation failure. */
+int cursorAllByID(FlightCursor *c, TreeNode *root);
+/* Flights in ascending ID order with ID > afterID: pass the last ID of a previous
+   page to resume by key. Returns 0 on allocation failure. */
+int cursorSortedByID(FlightCursor *c, TreeNode *root, int afterID);
+void cursorOverArray(FlightCursor *c, const Flight **items, size_t count);
+/* Restrict any cursor to flights with an instance on date (days since 1970-01-01) */
+void cursorFilterDate(FlightCursor *c, int date);
+/* Next result, or NULL when exhausted */
+const Flight* cursorNext(FlightCursor *c);
+/* Fill up to max results into out; returns how many were written (0 = done) */
+size_t cursorPage(FlightCursor *c, const Flight **out, size_t max);
+void closeCursor(FlightCursor *c);
+
+typedef enum {
+    FORMAT_TEXT,  /* same lines as printFlight */
+    FORMAT_CSV,   /* flights.txt row format */
+    FORMAT_JSON   /* one JSON array */
+} OutputFormat;
+
+/* Drain the cursor into fp through one large buffer (a few writes instead of
+   one stdio call per field). Returns the number of flights written. */
+size_t writeFlights(FILE *fp, FlightCursor *c, OutputFormat format);
+/* Format a single flight (used by printFlight) */
+void writeFlight(FILE *fp, const Flight *flight, OutputFormat format);
+
+#endif
@@ -0,0 +1,91 @@
+#include <stdlib.h>
+#include <string.h>
+#include "symtab.h"
+
+/* Global intern table:
+ * - names[] holds one heap copy of every distinct string, indexed by SymbolID.
+ * - slots[] is an open-addressing hash table (linear probing) of SymbolIDs,
+ *   kept at most half full so probes stay short.
+ */
+static char **names = NULL;
+static uint32_t nameCount = 0;
+static uint32_t nameCapacity = 0;
+static SymbolID *slots = NULL;
+static uint32_t slotCount = 0; /* power of two */
+
+/* FNV-1a */
+static uint32_t hashText(const char *text) {
+    uint32_t h = 2166136261u;
+    for (const unsigned char *p = (const unsigned char*)text; *p; ++p) {
+        h ^= *p;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static uint32_t findSlot(const char *text, uint32_t h) {
+    uint32_t mask = slotCount - 1;
+    uint32_t i = h & mask;
+    while (slots[i] != SYMBOL_NONE && strcmp(names[slots[i]], text) != 0) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static int growSlots(void) {
+    uint32_t newCount = slotCount ? slotCount * 2 : 64;
+    SymbolID *newSlots = (SymbolID*)malloc(sizeof(SymbolID) * newCount);
+    if (!newSlots) return 0;
+    for (uint32_t i = 0; i < newCount; ++i) newSlots[i] = SYMBOL_NONE;
+    free(slots);
+    slots = newSlots;
+    slotCount = newCount;
+    for (SymbolID id = 0; id < nameCount; ++id) {
+        slots[findSlot(names[id], hashText(names[id]))] = id;
+    }
+    return 1;
+}
+
+SymbolID lookupSymbol(const char *text) {
+    if (!text || !slots) return SYMBOL_NONE;
+    return slots[findSlot(text, hashText(text))];
+}
+
+SymbolID internSymbol(const char *text) {
+    if (!text) return SYMBOL_NONE;
+    if ((nameCount + 1) * 2 > slotCount && !growSlots()) return SYMBOL_NONE;
+    uint32_t slot = findSlot(text, hashText(text));
+    if (slots[slot] != SYMBOL_NONE) return slots[slot];
+    if (nameCount == nameCapacity) {
+        uint32_t cap = nameCapacity ? nameCapacity * 2 : 32;
+        char **newNames = (char**)realloc(names, sizeof(char*) * cap);
+        if (!newNames) return SYMBOL_NONE;
+        names = newNames;
+        nameCapacity = cap;
+    }
+    size_t len = strlen(text);
+    char *copy = (char*)malloc(len + 1);
+    if (!copy) return SYMBOL_NONE;
+    memcpy(copy, text, len + 1);
+    names[nameCount] = copy;
+    slots[slot] = nameCount;
+    return nameCount++;
+}
+
+const char* symbolName(SymbolID id) {
+    if (id >= nameCount) return "";
+    return names[id];
+}
+
+uint32_t symbolCount(void) {
+    return nameCount;
+}
+
+void freeSymbols(void) {
+    for (uint32_t i = 0; i < nameCount; ++i) free(names[i]);
+    free(names);
+    free(slots);
+    names = NULL;
+    slots = NULL;
+    nameCount = nameCapacity = slotCount = 0;
+}
@@ -0,0 +1,22 @@
+#ifndef SYMTAB_H
+#define SYMTAB_H
+
+#include <stdint.h>
+
+/* Interned string handle. Equal strings always get the same ID,
+   so names can be compared with == instead of strcmp. */
+typedef uint32_t SymbolID;
+
+#define SYMBOL_NONE ((SymbolID)0xFFFFFFFFu)
+
+/* Return the ID for text, adding it to the table if needed (SYMBOL_NONE on allocation failure) */
+SymbolID internSymbol(const char *text);
+/* Return the ID for text without adding it (SYMBOL_NONE if never interned) */
+SymbolID lookupSymbol(const char *text);
+/* Text of an interned symbol ("" for SYMBOL_NONE / unknown IDs) */
+const char* symbolName(SymbolID id);
+/* Number of interned symbols; valid IDs are 0 .. symbolCount()-1 */
+uint32_t symbolCount(void);
+void freeSymbols(void);
+
+#endif
@@ -0,0 +1,279 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "timeindex.h"
+#include "psort.h"
+
+/* Helper: find airport entry by name (direct table lookup) */
+static AirportTimes* findAirportTimes(const TimeIndex *idx, SymbolID name) {
+    if (name >= idx->symbolSlots) return NULL;
+    return idx->bySymbol[name];
+}
+
+/* Create and prepend airport entry, growing the lookup table to cover name */
+static AirportTimes* createAirportTimes(TimeIndex *idx, SymbolID name) {
+    if (name == SYMBOL_NONE) return NULL;
+    if (name >= idx->symbolSlots) {
+        uint32_t slots = symbolCount() > name ? symbolCount() : name + 1;
+        AirportTimes **table = (AirportTimes**)realloc(idx->bySymbol, sizeof(AirportTimes*) * slots);
+        if (!table) return NULL;
+        memset(table + idx->symbolSlots, 0, sizeof(AirportTimes*) * (slots - idx->symbolSlots));
+        idx->bySymbol = table;
+        idx->symbolSlots = slots;
+    }
+    AirportTimes *a = (AirportTimes*)calloc(1, sizeof(AirportTimes));
+    if (!a) return NULL;
+    a->name = name;
+    a->next = idx->airports;
+    idx->airports = a;
+    idx->bySymbol[name] = a;
+    return a;
+}
+
+/* Ordering key: minutes, then flight id so equal times have a stable order */
+static int entryLess(const TimeEntry *e, int minutes, int id) {
+    if (e->minutes != minutes) return e->minutes < minutes;
+    return e->fnode->flight.id < id;
+}
+
+/* First position whose entry is not less than (minutes, id) */
+static size_t lowerBound(const TimeSlots *s, int minutes, int id) {
+    size_t lo = 0, hi = s->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (entryLess(&s->items[mid], minutes, id)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/* First position with entry minutes >= minutes */
+static size_t lowerBoundMinutes(const TimeSlots *s, int minutes) {
+    size_t lo = 0, hi = s->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (s->items[mid].minutes < minutes) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static int slotsInsert(TimeSlots *s, int minutes, FlightNode *fnode) {
+    if (s->count == s->capacity) {
+        size_t cap = s->capacity ? s->capacity * 2 : 8;
+        TimeEntry *items = (TimeEntry*)realloc(s->items, cap * sizeof(TimeEntry));
+        if (!items) return 0;
+        s->items = items;
+        s->capacity = cap;
+    }
+    size_t pos = lowerBound(s, minutes, fnode->flight.id);
+    memmove(&s->items[pos + 1], &s->items[pos], (s->count - pos) * sizeof(TimeEntry));
+    s->items[pos].minutes = minutes;
+    s->items[pos].fnode = fnode;
+    s->count++;
+    return 1;
+}
+
+/* Duplicate IDs can share a (minutes, id) key, so match the node itself in that run */
+static int slotsRemove(TimeSlots *s, int minutes, const FlightNode *fnode) {
+    int id = fnode->flight.id;
+    size_t pos = lowerBound(s, minutes, id);
+    while (pos < s->count && s->items[pos].minutes == minutes && s->items[pos].fnode->flight.id == id &&
+           s->items[pos].fnode != fnode) pos++;
+    if (pos >= s->count || s->items[pos].fnode != fnode) return 0;
+    memmove(&s->items[pos], &s->items[pos + 1], (s->count - pos - 1) * sizeof(TimeEntry));
+    s->count--;
+    return 1;
+}
+
+void initTimeIndex(TimeIndex *idx) {
+    idx->airports = NULL;
+    idx->bySymbol = NULL;
+    idx->symbolSlots = 0;
+}
+
+void buildTimeIndex(TimeIndex *idx, FlightNode *flights) {
+    if (!idx) return;
+    size_t count = 0;
+    FlightNode **nodes = flightArray(flights, &count);
+    if (!nodes || !buildTimeIndexFromArray(idx, nodes, count)) {
+        fprintf(stderr, "Memory allocation failed while building time index.\n");
+        freeTimeIndex(idx);
+    }
+    free(nodes);
+}
+
+void freeTimeIndex(TimeIndex *idx) {
+    if (!idx) return;
+    AirportTimes *cur = idx->airports;
+    while (cur) {
+        AirportTimes *tmp = cur;
+        cur = cur->next;
+        free(tmp->departures.items);
+        free(tmp->arrivals.items);
+        free(tmp);
+    }
+    free(idx->bySymbol);
+    initTimeIndex(idx);
+}
+
+static int compareEntries(const void *a, const void *b) {
+    const TimeEntry *ea = (const TimeEntry*)a;
+    const TimeEntry *eb = (const TimeEntry*)b;
+    if (entryLess(ea, eb->minutes, eb->fnode->flight.id)) return -1;
+    if (entryLess(eb, ea->minutes, ea->fnode->flight.id)) return 1;
+    return 0;
+}
+
+/* Task 2*i sorts airport i's departures, 2*i+1 its arrivals */
+static void sortAirportSlots(int task, void *ctx) {
+    AirportTimes *a = ((AirportTimes**)ctx)[task / 2];
+    TimeSlots *s = (task % 2 == 0) ? &a->departures : &a->arrivals;
+    if (s->count) qsort(s->items, s->count, sizeof(TimeEntry), compareEntries);
+}
+
+/* Reserve exactly-sized slot arrays (counts were accumulated into capacity) */
+static int reserveSlots(TimeSlots *s) {
+    if (!s->capacity) return 1;
+    s->items = (TimeEntry*)malloc(sizeof(TimeEntry) * s->capacity);
+    return s->items != NULL;
+}
+
+int buildTimeIndexFromArray(TimeIndex *idx, FlightNode **nodes, size_t count) {
+    if (!idx) return 0;
+    TimeIndex fresh;
+    initTimeIndex(&fresh);
+    int ok = 1;
+
+    /* pass 1: create airports and count events per airport */
+    for (size_t i = 0; i < count && ok; ++i) {
+        const Flight *f = &nodes[i]->flight;
+        SymbolID ends[2] = { f->source, f->destination };
+        int times[2] = { f->departure, f->arrival };
+        for (int e = 0; e < 2 && ok; ++e) {
+            if (times[e] < 0 || ends[e] >= symbolCount()) continue;
+            AirportTimes *a = findAirportTimes(&fresh, ends[e]);
+            if (!a) a = createAirportTimes(&fresh, ends[e]);
+            if (!a) { ok = 0; break; }
+            if (e == 0) a->departures.capacity++;
+            else a->arrivals.capacity++;
+        }
+    }
+    for (AirportTimes *a = fresh.airports; a && ok; a = a->next) {
+        ok = reserveSlots(&a->departures) && reserveSlots(&a->arrivals);
+    }
+    /* pass 2: fill, then sort each airport's runs once */
+    for (size_t i = 0; i < count && ok; ++i) {
+        const Flight *f = &nodes[i]->flight;
+        if (f->departure >= 0 && f->source < symbolCount()) {
+            TimeSlots *s = &findAirportTimes(&fresh, f->source)->departures;
+            s->items[s->count].minutes = f->departure;
+            s->items[s->count++].fnode = nodes[i];
+        }
+        if (f->arrival >= 0 && f->destination < symbolCount()) {
+            TimeSlots *s = &findAirportTimes(&fresh, f->destination)->arrivals;
+            s->items[s->count].minutes = f->arrival;
+            s->items[s->count++].fnode = nodes[i];
+        }
+    }
+    /* sort each airport's departures and arrivals concurrently */
+    size_t airportCount = 0;
+    for (AirportTimes *a = fresh.airports; a; a = a->next) airportCount++;
+    AirportTimes **airports = ok ? (AirportTimes**)malloc(sizeof(AirportTimes*) * (airportCount + 1)) : NULL;
+    if (!airports) {
+        freeTimeIndex(&fresh);
+        return 0;
+    }
+    airportCount = 0;
+    for (AirportTimes *a = fresh.airports; a; a = a->next) airports[airportCount++] = a;
+    parallelRun((int)(airportCount * 2), sortAirportSlots, airports);
+    free(airports);
+    freeTimeIndex(idx);
+    *idx = fresh;
+    return 1;
+}
+
+int timeIndexAdd(TimeIndex *idx, FlightNode *fnode) {
+    if (!idx || !fnode) return 0;
+    const Flight *f = &fnode->flight;
+    int dep = f->departure;
+    int arr = f->arrival;
+    int ok = 1;
+    if (dep >= 0) {
+        AirportTimes *src = findAirportTimes(idx, f->source);
+        if (!src) src = createAirportTimes(idx, f->source);
+        ok = src && slotsInsert(&src->departures, dep, fnode);
+    }
+    if (arr >= 0) {
+        AirportTimes *dst = findAirportTimes(idx, f->destination);
+        if (!dst) dst = createAirportTimes(idx, f->destination);
+        ok = dst && slotsInsert(&dst->arrivals, arr, fnode) && ok;
+    }
+    return ok;
+}
+
+int timeIndexRemove(TimeIndex *idx, const FlightNode *fnode) {
+    if (!idx || !fnode) return 0;
+    const Flight *flight = &fnode->flight;
+    int removed = 0;
+    int dep = flight->departure;
+    int arr = flight->arrival;
+    AirportTimes *src = findAirportTimes(idx, flight->source);
+    if (src && dep >= 0) removed |= slotsRemove(&src->departures, dep, fnode);
+    AirportTimes *dst = findAirportTimes(idx, flight->destination);
+    if (dst && arr >= 0) removed |= slotsRemove(&dst->arrivals, arr, fnode);
+    return removed;
+}
+
+/* Fill one span covering [fromMin, toMin]; returns 1 if non-empty */
+static int querySlots(const TimeSlots *s, int fromMin, int toMin, TimeSpan *span) {
+    size_t first = lowerBoundMinutes(s, fromMin);
+    size_t last = lowerBoundMinutes(s, toMin + 1);
+    if (first >= last) return 0;
+    span->items = &s->items[first];
+    span->count = last - first;
+    return 1;
+}
+
+int timeIndexQuery(const TimeIndex *idx, const char *airport, TimeDirection dir,
+                   int fromMin, int toMin, TimeSpan spans[2]) {
+    if (!airport) return 0;
+    return timeIndexQueryByID(idx, lookupSymbol(airport), dir, fromMin, toMin, spans);
+}
+
+int timeIndexQueryByID(const TimeIndex *idx, SymbolID airport, TimeDirection dir,
+                       int fromMin, int toMin, TimeSpan spans[2]) {
+    if (!idx || !spans) return 0;
+    if (fromMin < 0 || fromMin >= MINUTES_PER_DAY || toMin < 0 || toMin >= MINUTES_PER_DAY) return 0;
+    AirportTimes *a = findAirportTimes(idx, airport);
+    if (!a) return 0;
+    const TimeSlots *s = (dir == TIME_DEPARTURES) ? &a->departures : &a->arrivals;
+    int n = 0;
+    if (fromMin <= toMin) {
+        n += querySlots(s, fromMin, toMin, &spans[n]);
+    } else {
+        /* wraps past midnight: [fromMin, 23:59] then [00:00, toMin] */
+        n += querySlots(s, fromMin, MINUTES_PER_DAY - 1, &spans[n]);
+        n += querySlots(s, 0, toMin, &spans[n]);
+    }
+    return n;
+}
+
+size_t printFlightsInWindow(const TimeIndex *idx, const char *airport, TimeDirection dir,
+                            int fromMin, int toMin) {
+    TimeSpan spans[2];
+    int n = timeIndexQuery(idx, airport, dir, fromMin, toMin, spans);
+    size_t printed = 0;
+    for (int i = 0; i < n; ++i) {
+        for (size_t j = 0; j < spans[i].count; ++j) {
+            printFlight(&spans[i].items[j].fnode->flight);
+            printed++;
+        }
+    }
+    if (!printed) {
+        printf("No %s at '%s' between %02d:%02d and %02d:%02d.\n",
+               dir == TIME_DEPARTURES ? "departures" : "arrivals", airport,
+               fromMin / 60, fromMin % 60, toMin / 60, toMin % 60);
+    }
+    return printed;
+}
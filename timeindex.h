@@ -0,0 +1,75 @@
+#ifndef TIMEINDEX_H
+#define TIMEINDEX_H
+
+#include <stddef.h>
+#include "flight.h"
+
+#define MINUTES_PER_DAY 1440
+
+/* One indexed event: a flight departing from / arriving at an airport */
+typedef struct {
+    int minutes;        /* minutes since midnight (0..1439) */
+    FlightNode *fnode;  /* borrowed pointer into the flight list */
+} TimeEntry;
+
+/* Growable array kept sorted by (minutes, flight id) */
+typedef struct {
+    TimeEntry *items;
+    size_t count;
+    size_t capacity;
+} TimeSlots;
+
+/* Per-airport departure and arrival schedules. Airports stored in a linked list. */
+typedef struct AirportTimes {
+    SymbolID name;
+    TimeSlots departures;
+    TimeSlots arrivals;
+    struct AirportTimes *next;
+} AirportTimes;
+
+typedef struct {
+    AirportTimes *airports;
+    AirportTimes **bySymbol; /* airport lookup by SymbolID (NULL = no entry) */
+    uint32_t symbolSlots;    /* length of bySymbol */
+} TimeIndex;
+
+typedef enum {
+    TIME_DEPARTURES,
+    TIME_ARRIVALS
+} TimeDirection;
+
+/* Contiguous run of matching entries (borrowed from the index) */
+typedef struct {
+    const TimeEntry *items;
+    size_t count;
+} TimeSpan;
+
+void initTimeIndex(TimeIndex *idx);
+/* Build index from flights linked list; frees existing contents first */
+void buildTimeIndex(TimeIndex *idx, FlightNode *flights);
+void freeTimeIndex(TimeIndex *idx);
+/* Bulk build: group entries by airport, then sort each group once.
+   Returns 1 and replaces *idx, or 0 on allocation failure (*idx untouched). */
+int buildTimeIndexFromArray(TimeIndex *idx, FlightNode **nodes, size_t count);
+
+/* Keep the index in sync with the flight list. Times equal to TIME_NONE
+   are not indexed. Returns 1 on success, 0 on failure / not found.
+   timeIndexRemove drops this node's entries (not another flight with the same ID)
+   and must be called before the node is freed or its times change. */
+int timeIndexAdd(TimeIndex *idx, FlightNode *fnode);
+int timeIndexRemove(TimeIndex *idx, const FlightNode *fnode);
+
+/* Range query over [fromMin, toMin] (inclusive) at an airport in O(log n + k).
+   A window with fromMin > toMin wraps past midnight and yields two spans.
+   Returns the number of spans written to spans[] (0, 1 or 2). */
+int timeIndexQuery(const TimeIndex *idx, const char *airport, TimeDirection dir,
+                   int fromMin, int toMin, TimeSpan spans[2]);
+/* Same query with the airport given as an interned symbol */
+int timeIndexQueryByID(const TimeIndex *idx, SymbolID airport, TimeDirection dir,
+                       int fromMin, int toMin, TimeSpan spans[2]);
+
+/* Print all flights in the window; returns the number of flights printed */
+size_t printFlightsInWindow(const TimeIndex *idx, const char *airport, TimeDirection dir,
+                            int fromMin, int toMin);
+
+#endif
@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "tree.h"
+#include "query.h"
+#include "psort.h"
 
 TreeNode* createTreeNode(FlightNode *fnode) {
     TreeNode *n = (TreeNode*)malloc(sizeof(TreeNode));
@@ -23,16 +25,152 @@ TreeNode* insertTreeNode(TreeNode *root, FlightNode *fnode) {
     return root;
 }
 
+/* A node with its index in the input array, so equal IDs sort by position */
+typedef struct {
+    FlightNode *fnode;
+    size_t pos;
+} RankedNode;
+
+static int compareByID(const void *a, const void *b) {
+    const RankedNode *x = (const RankedNode*)a;
+    const RankedNode *y = (const RankedNode*)b;
+    if (x->fnode->flight.id != y->fnode->flight.id) return x->fnode->flight.id < y->fnode->flight.id ? -1 : 1;
+    return (x->pos > y->pos) - (x->pos < y->pos);
+}
+
+int sortNodesByID(FlightNode **nodes, size_t count) {
+    RankedNode *ranked = (RankedNode*)malloc(sizeof(RankedNode) * (count ? count : 1));
+    if (!ranked) return 0;
+    for (size_t i = 0; i < count; ++i) {
+        ranked[i].fnode = nodes[i];
+        ranked[i].pos = i;
+    }
+    parallelSort(ranked, count, sizeof(RankedNode), compareByID);
+    for (size_t i = 0; i < count; ++i) nodes[i] = ranked[i].fnode;
+    free(ranked);
+    return 1;
+}
+
+size_t uniqueByID(FlightNode **sorted, size_t count) {
+    size_t unique = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (unique == 0 || sorted[unique - 1]->flight.id != sorted[i]->flight.id) sorted[unique++] = sorted[i];
+    }
+    return unique;
+}
+
+/* Bulk path: gather, parallel-sort by ID, then emit a balanced tree */
 TreeNode* buildTreeFromList(FlightNode *head) {
+    size_t count = 0;
+    FlightNode **nodes = flightArray(head, &count);
     TreeNode *root = NULL;
-    FlightNode *cur = head;
-    while (cur) {
-        root = insertTreeNode(root, cur);
-        cur = cur->next;
+    if (!nodes || !sortNodesByID(nodes, count)) {
+        fprintf(stderr, "Memory allocation failed while building flight index.\n");
+        free(nodes);
+        return NULL;
+    }
+    /* duplicate IDs (e.g. non-numeric IDs loaded as 0): the index keeps the first
+       in list order, the same node searchFlightByID finds */
+    size_t unique = uniqueByID(nodes, count);
+    if (!buildTreeFromSorted(nodes, unique, &root)) {
+        fprintf(stderr, "Memory allocation failed while building flight index.\n");
+        root = NULL;
     }
+    free(nodes);
     return root;
 }
 
+/* Midpoint recursion: depth is O(log n) regardless of input order */
+static TreeNode* buildBalanced(FlightNode **nodes, size_t count, int *ok) {
+    if (count == 0 || !*ok) return NULL;
+    size_t mid = count / 2;
+    TreeNode *n = createTreeNode(nodes[mid]);
+    if (!n) {
+        *ok = 0;
+        return NULL;
+    }
+    n->left = buildBalanced(nodes, mid, ok);
+    n->right = buildBalanced(nodes + mid + 1, count - mid - 1, ok);
+    return n;
+}
+
+/* Subtrees below the top `depth` levels are independent ranges of the sorted
+   array, so they are built concurrently and then linked under the top levels.
+   The shape is identical to a single-threaded midpoint build. */
+#define PARALLEL_TREE_MIN 65536
+
+typedef struct {
+    FlightNode **nodes;
+    size_t count;
+    TreeNode *root;
+    int ok;
+} SubtreeTask;
+
+static void collectSubtrees(FlightNode **nodes, size_t count, int depth,
+                            SubtreeTask *tasks, int *n) {
+    if (depth == 0) {
+        tasks[*n].nodes = nodes;
+        tasks[*n].count = count;
+        tasks[*n].root = NULL;
+        tasks[*n].ok = 1;
+        (*n)++;
+        return;
+    }
+    size_t mid = count / 2;
+    collectSubtrees(nodes, count ? mid : 0, depth - 1, tasks, n);
+    collectSubtrees(nodes + mid + 1, count ? count - mid - 1 : 0, depth - 1, tasks, n);
+}
+
+static void buildSubtree(int task, void *ctx) {
+    SubtreeTask *t = &((SubtreeTask*)ctx)[task];
+    t->root = buildBalanced(t->nodes, t->count, &t->ok);
+}
+
+/* Walk the top levels in the same order as collectSubtrees, consuming task roots */
+static TreeNode* linkTop(FlightNode **nodes, size_t count, int depth,
+                         SubtreeTask *tasks, int *next, int *ok) {
+    if (depth == 0) return tasks[(*next)++].root;
+    size_t mid = count / 2;
+    TreeNode *left = linkTop(nodes, count ? mid : 0, depth - 1, tasks, next, ok);
+    TreeNode *right = linkTop(nodes + mid + 1, count ? count - mid - 1 : 0, depth - 1, tasks, next, ok);
+    if (count == 0) return NULL;
+    TreeNode *n = *ok ? createTreeNode(nodes[mid]) : NULL;
+    if (!n) {
+        *ok = 0;
+        freeTree(left);
+        freeTree(right);
+        return NULL;
+    }
+    n->left = left;
+    n->right = right;
+    return n;
+}
+
+int buildTreeFromSorted(FlightNode **nodes, size_t count, TreeNode **out) {
+    int ok = 1;
+    int depth = 0;
+    /* split into ~one subtree per worker, only when the input is large enough */
+    if (count >= PARALLEL_TREE_MIN) {
+        while ((1 << depth) < parallelWorkers() && depth < 6) depth++;
+    }
+    SubtreeTask tasks[64];
+    int n = 0;
+    collectSubtrees(nodes, count, depth, tasks, &n);
+    parallelRun(n, buildSubtree, tasks);
+    for (int i = 0; i < n; ++i) {
+        if (!tasks[i].ok) ok = 0;
+    }
+    int next = 0;
+    TreeNode *root = linkTop(nodes, count, depth, tasks, &next, &ok);
+    if (!ok) {
+        /* linkTop frees task subtrees on failure; only a depth-0 partial tree remains */
+        freeTree(root);
+        return 0;
+    }
+    *out = root;
+    return 1;
+}
+
 FlightNode* treeSearchByID(TreeNode *root, int id) {
     while (root) {
         if (id == root->fnode->flight.id) return root->fnode;
@@ -42,11 +180,32 @@ FlightNode* treeSearchByID(TreeNode *root, int id) {
     return NULL;
 }
 
+FlightNode* treeSearchInstance(TreeNode *root, int id, int date) {
+    FlightNode *f = treeSearchByID(root, id);
+    if (f && !flightOperatesOn(&f->flight, date)) return NULL;
+    return f;
+}
+
+size_t printFlightsOnDate(TreeNode *root, int date) {
+    FlightCursor c;
+    if (!cursorAllByID(&c, root)) {
+        printf("Memory allocation failed for index traversal.\n");
+        return 0;
+    }
+    cursorFilterDate(&c, date);
+    size_t n = writeFlights(stdout, &c, FORMAT_TEXT);
+    closeCursor(&c);
+    return n;
+}
+
 void inorderPrintTree(TreeNode *root) {
-    if (!root) return;
-    inorderPrintTree(root->left);
-    printFlight(&(root->fnode->flight));
-    inorderPrintTree(root->right);
+    FlightCursor c;
+    if (!cursorAllByID(&c, root)) {
+        printf("Memory allocation failed for index traversal.\n");
+        return;
+    }
+    writeFlights(stdout, &c, FORMAT_TEXT);
+    closeCursor(&c);
 }
 
 void freeTree(TreeNode *root) {
@@ -13,7 +13,19 @@ typedef struct TreeNode {
 TreeNode* createTreeNode(FlightNode *fnode);
 TreeNode* insertTreeNode(TreeNode *root, FlightNode *fnode);
 TreeNode* buildTreeFromList(FlightNode *head);
+/* Sort nodes by ascending ID; equal IDs keep their array order (list order for an
+   array from flightArray). Returns 0 on allocation failure (nodes unchanged). */
+int sortNodesByID(FlightNode **nodes, size_t count);
+/* Drop all but the first node of each ID from a sorted array; returns the new count */
+size_t uniqueByID(FlightNode **sorted, size_t count);
+/* Balanced index from nodes already sorted by ascending, unique flight ID.
+   Returns 1 and stores the root in *out, or 0 on allocation failure (nothing leaked). */
+int buildTreeFromSorted(FlightNode **nodes, size_t count, TreeNode **out);
 FlightNode* treeSearchByID(TreeNode *root, int id);
+/* Dated lookup on the schedule index: the flight with this ID if it operates on date */
+FlightNode* treeSearchInstance(TreeNode *root, int id, int date);
+/* Print (in ID order) every flight with an instance on date; returns the count */
+size_t printFlightsOnDate(TreeNode *root, int date);
 void inorderPrintTree(TreeNode *root);
 void freeTree(TreeNode *root);
 